@@ -22,6 +22,7 @@ for arg in $@; do
         echo "    clippy        validate clippy lints"
         echo "    test          run unit tests (no Godot)"
         echo "    itest         run integration tests (Godot)"
+        echo "    bench         run FFI benchmarks (Godot), print JSON report"
         echo "    doc           generate docs for 'godot' crate"
         echo "    dok           generate docs and open in browser"
         echo ""
@@ -104,6 +105,12 @@ for arg in "${args[@]}"; do
         cmds+=("cargo $toolchain build -p itest $extraArgs")
         cmds+=("$godotBin --path itest/godot --headless")
         ;;
+    bench)
+        findGodot
+
+        cmds+=("cargo $toolchain build -p itest $extraArgs")
+        cmds+=("$godotBin --path itest/godot --headless -- --bench")
+        ;;
     doc)
         cmds+=("cargo $toolchain doc --lib -p godot --no-deps $extraArgs")
         ;;
@@ -9,7 +9,7 @@
 #![allow(dead_code)]
 #![allow(clippy::question_mark)] // in #[derive(DeJson)]
 
-use crate::{godot_exe, StopWatch};
+use crate::StopWatch;
 
 use nanoserde::DeJson;
 
@@ -219,7 +219,8 @@ impl MethodReturn {
 // ----------------------------------------------------------------------------------------------------------------------------------------------
 // Implementation
 
-pub fn load_extension_api(watch: &mut StopWatch) -> (ExtensionApi, &'static str) {
+/// Parses the JSON obtained by [`crate::godot_exe::load_extension_api_json()`].
+pub fn load_extension_api(json: &str, watch: &mut StopWatch) -> (ExtensionApi, &'static str) {
     // For float/double inference, see:
     // * https://github.com/godotengine/godot-proposals/issues/892
     // * https://github.com/godotengine/godot-cpp/pull/728
@@ -228,9 +229,7 @@ pub fn load_extension_api(watch: &mut StopWatch) -> (ExtensionApi, &'static str)
     #[cfg(not(feature = "double-precision"))]
     let build_config = "float_64"; // TODO infer this
 
-    let json: String = godot_exe::load_extension_api_json(watch);
-
-    let model: ExtensionApi = DeJson::deserialize_json(&json).expect("failed to deserialize JSON");
+    let model: ExtensionApi = DeJson::deserialize_json(json).expect("failed to deserialize JSON");
     watch.record("deserialize_json");
 
     (model, build_config)
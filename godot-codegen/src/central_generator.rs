@@ -11,7 +11,7 @@ use std::path::{Path, PathBuf};
 
 use crate::api_parser::*;
 use crate::util::{to_pascal_case, to_rust_type, to_snake_case};
-use crate::{ident, util, Context};
+use crate::{ident, special_cases, util, Context};
 
 struct CentralItems {
     opaque_types: Vec<TokenStream>,
@@ -22,6 +22,7 @@ struct CentralItems {
     variant_op_enumerators_ord: Vec<Literal>,
     variant_fn_decls: Vec<TokenStream>,
     variant_fn_inits: Vec<TokenStream>,
+    string_name_from_string_index: Literal,
     global_enum_defs: Vec<TokenStream>,
 }
 
@@ -49,6 +50,7 @@ pub(crate) struct BuiltinTypeInfo<'a> {
     pub has_destructor: bool,
     pub constructors: Option<&'a Vec<Constructor>>,
     pub operators: Option<&'a Vec<Operator>>,
+    pub methods: Option<&'a Vec<BuiltinClassMethod>>,
 }
 
 pub(crate) fn generate_sys_central_file(
@@ -126,6 +128,7 @@ fn make_sys_code(central_items: &CentralItems) -> String {
         variant_op_enumerators_ord,
         variant_fn_decls,
         variant_fn_inits,
+        string_name_from_string_index,
         ..
     } = central_items;
 
@@ -142,6 +145,11 @@ fn make_sys_code(central_items: &CentralItems) -> String {
 
         impl GlobalMethodTable {
             pub(crate) unsafe fn new(interface: &crate::GDExtensionInterface) -> Self {
+                let builtin_loader = crate::method_loader::BuiltinMethodLoader::new(
+                    interface,
+                    #string_name_from_string_index,
+                );
+
                 Self {
                     #(#variant_fn_inits)*
                 }
@@ -289,6 +297,7 @@ fn make_central_items(api: &ExtensionApi, build_config: &str, ctx: &mut Context)
         variant_op_enumerators_ord: Vec::new(),
         variant_fn_decls: Vec::with_capacity(len),
         variant_fn_inits: Vec::with_capacity(len),
+        string_name_from_string_index: find_string_name_from_string(&builtin_types_map),
         global_enum_defs: Vec::new(),
     };
 
@@ -306,6 +315,8 @@ fn make_central_items(api: &ExtensionApi, build_config: &str, ctx: &mut Context)
             &builtin_types_map,
         );
 
+        let (method_decls, method_inits) = make_builtin_method_fns(&ty.type_names, ty.methods);
+
         let (pascal_name, rust_ty, ord) = make_enumerator(&ty.type_names, ty.value, ctx);
 
         result.variant_ty_enumerators_pascal.push(pascal_name);
@@ -313,6 +324,8 @@ fn make_central_items(api: &ExtensionApi, build_config: &str, ctx: &mut Context)
         result.variant_ty_enumerators_ord.push(ord);
         result.variant_fn_decls.push(decls);
         result.variant_fn_inits.push(inits);
+        result.variant_fn_decls.push(method_decls);
+        result.variant_fn_inits.push(method_inits);
     }
 
     for op in variant_operators {
@@ -390,17 +403,20 @@ pub(crate) fn collect_builtin_types(api: &ExtensionApi) -> HashMap<String, Built
         let has_destructor: bool;
         let constructors: Option<&Vec<Constructor>>;
         let operators: Option<&Vec<Operator>>;
+        let methods: Option<&Vec<BuiltinClassMethod>>;
         if let Some(class) = class_map.get(&normalized) {
             class_name = class.name.clone();
             has_destructor = class.has_destructor;
             constructors = Some(&class.constructors);
             operators = Some(&class.operators);
+            methods = class.methods.as_ref();
         } else {
             assert_eq!(normalized, "object");
             class_name = "Object".to_string();
             has_destructor = false;
             constructors = None;
             operators = None;
+            methods = None;
         }
 
         let type_names = TypeNames {
@@ -420,6 +436,7 @@ pub(crate) fn collect_builtin_types(api: &ExtensionApi) -> HashMap<String, Built
                 has_destructor,
                 constructors,
                 operators,
+                methods,
             },
         );
     }
@@ -692,6 +709,83 @@ fn make_operator_fns(
     (decl, init)
 }
 
+/// Name of the `GlobalMethodTable` field holding the ptrcall function for a builtin method, e.g. `array_method_size`.
+///
+/// Kept distinct from constructor names like `color_from_string`, which could otherwise collide with static methods.
+pub(crate) fn make_builtin_method_ident(
+    type_names: &TypeNames,
+    method: &BuiltinClassMethod,
+) -> Ident {
+    format_ident!("{}_method_{}", type_names.snake_case, method.name)
+}
+
+/// Resolves all builtin methods of a type once, so that generated `Inner*` wrappers don't look them up on every call.
+fn make_builtin_method_fns(
+    type_names: &TypeNames,
+    methods: Option<&Vec<BuiltinClassMethod>>,
+) -> (TokenStream, TokenStream) {
+    let methods = match methods {
+        Some(m) => m,
+        None => return (TokenStream::new(), TokenStream::new()),
+    };
+
+    // Must stay in sync with the methods generated in class_generator::make_builtin_method_definition()
+    if special_cases::is_builtin_scalar(&type_names.json_builtin_name) {
+        return (TokenStream::new(), TokenStream::new());
+    }
+
+    let variant_type = &type_names.sys_variant_type;
+    let mut decls = Vec::with_capacity(methods.len());
+    let mut inits = Vec::with_capacity(methods.len());
+
+    // TODO varcall methods are not yet generated
+    for method in methods.iter().filter(|m| !m.is_vararg) {
+        let ident = make_builtin_method_ident(type_names, method);
+        let error = format_load_error(&ident);
+        let name = &method.name;
+        let hash = method.hash.unwrap_or_else(|| {
+            panic!(
+                "builtin method {}::{} has no hash",
+                type_names.json_builtin_name, method.name
+            )
+        });
+
+        decls.push(quote! {
+            pub #ident: unsafe extern "C" fn(
+                GDExtensionTypePtr,
+                *const GDExtensionConstTypePtr,
+                GDExtensionTypePtr,
+                std::os::raw::c_int,
+            ),
+        });
+
+        inits.push(quote! {
+            #ident: builtin_loader.load(crate::#variant_type, #name, #hash).expect(#error),
+        });
+    }
+
+    (quote! { #(#decls)* }, quote! { #(#inits)* })
+}
+
+/// Index of the `StringName(String from)` constructor, needed to create method names during `GlobalMethodTable::new()`.
+fn find_string_name_from_string(builtin_types: &HashMap<String, BuiltinTypeInfo>) -> Literal {
+    let constructors = builtin_types
+        .get("StringName")
+        .and_then(|info| info.constructors)
+        .expect("missing constructors for StringName in JSON");
+
+    let ctor = constructors
+        .iter()
+        .find(|c| {
+            c.arguments
+                .as_ref()
+                .map_or(false, |args| args.len() == 1 && args[0].type_ == "String")
+        })
+        .expect("missing constructor StringName(String) in JSON");
+
+    Literal::i32_unsuffixed(ctor.index as i32)
+}
+
 fn format_load_error(ident: &impl std::fmt::Display) -> String {
     format!("failed to load GDExtension function `{ident}`")
 }
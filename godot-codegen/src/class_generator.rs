@@ -12,20 +12,21 @@ use quote::{format_ident, quote, ToTokens};
 use std::path::{Path, PathBuf};
 
 use crate::api_parser::*;
-use crate::central_generator::{collect_builtin_types, BuiltinTypeInfo};
+use crate::central_generator::{collect_builtin_types, make_builtin_method_ident, BuiltinTypeInfo};
 use crate::util::{ident, safe_ident, to_pascal_case, to_rust_type};
 use crate::{
     special_cases, util, Context, GeneratedBuiltin, GeneratedBuiltinModule, GeneratedClass,
     GeneratedClassModule, ModName, RustTy, TyName,
 };
 
+/// Returns the number of generated classes.
 pub(crate) fn generate_class_files(
     api: &ExtensionApi,
     ctx: &mut Context,
     _build_config: &str,
     gen_path: &Path,
     out_files: &mut Vec<PathBuf>,
-) {
+) -> usize {
     let _ = std::fs::remove_dir_all(gen_path);
     std::fs::create_dir_all(gen_path).expect("create classes directory");
 
@@ -34,8 +35,7 @@ pub(crate) fn generate_class_files(
         let class_name = TyName::from_godot(&class.name);
         let module_name = ModName::from_godot(&class.name);
 
-        #[cfg(not(feature = "codegen-full"))]
-        if !crate::SELECTED_CLASSES.contains(&class_name.godot_ty.as_str()) {
+        if !ctx.is_class_selected(&class_name.godot_ty) {
             continue;
         }
 
@@ -58,10 +58,14 @@ pub(crate) fn generate_class_files(
         });
     }
 
+    let generated_count = modules.len();
+
     let out_path = gen_path.join("mod.rs");
     let mod_contents = make_module_file(modules).to_string();
     std::fs::write(&out_path, mod_contents).expect("failed to write mod.rs file");
     out_files.push(out_path);
+
+    generated_count
 }
 
 pub(crate) fn generate_builtin_class_files(
@@ -121,7 +125,7 @@ fn make_constructor(class: &Class, ctx: &Context) -> TokenStream {
         quote! {
             pub fn singleton() -> Gd<Self> {
                 unsafe {
-                    let __class_name = StringName::from(#godot_class_name);
+                    let __class_name = crate::static_sname!(#godot_class_name);
                     let __object_ptr = sys::interface_fn!(global_get_singleton)(__class_name.string_sys());
                     Gd::from_obj_sys(__object_ptr)
                 }
@@ -135,7 +139,7 @@ fn make_constructor(class: &Class, ctx: &Context) -> TokenStream {
         quote! {
             pub fn new() -> Gd<Self> {
                 unsafe {
-                    let __class_name = StringName::from(#godot_class_name);
+                    let __class_name = crate::static_sname!(#godot_class_name);
                     let __object_ptr = sys::interface_fn!(classdb_construct_object)(__class_name.string_sys());
                     //let instance = Self { object_ptr };
                     Gd::from_obj_sys(__object_ptr)
@@ -148,7 +152,7 @@ fn make_constructor(class: &Class, ctx: &Context) -> TokenStream {
             #[must_use]
             pub fn new_alloc() -> Gd<Self> {
                 unsafe {
-                    let __class_name = StringName::from(#godot_class_name);
+                    let __class_name = crate::static_sname!(#godot_class_name);
                     let __object_ptr = sys::interface_fn!(classdb_construct_object)(__class_name.string_sys());
                     Gd::from_obj_sys(__object_ptr)
                 }
@@ -210,6 +214,11 @@ fn make_class(class: &Class, class_name: &TyName, ctx: &mut Context) -> Generate
                 type Mem = crate::obj::mem::#memory;
 
                 const CLASS_NAME: &'static str = #godot_class_str;
+
+                fn __class_tag() -> crate::obj::ClassTag {
+                    static CACHE: crate::obj::ClassTagCache = crate::obj::ClassTagCache::new();
+                    CACHE.get::<Self>()
+                }
             }
             impl crate::obj::EngineClass for #class_name {
                  fn as_object_ptr(&self) -> sys::GDExtensionObjectPtr {
@@ -446,11 +455,11 @@ fn make_special_builtin_methods(class_name: &TyName, _ctx: &Context) -> TokenStr
     }
 }
 
-#[cfg(not(feature = "codegen-full"))]
 fn is_type_excluded(ty: &str, ctx: &mut Context) -> bool {
-    let is_class_excluded = |class: &str| !crate::SELECTED_CLASSES.contains(&class);
+    let rust_ty = to_rust_type(ty, ctx);
+    let is_class_excluded = |class: &str| !ctx.is_class_selected(class);
 
-    match to_rust_type(ty, ctx) {
+    match rust_ty {
         RustTy::BuiltinIdent(_) => false,
         RustTy::BuiltinArray(_) => false,
         RustTy::EngineArray { elem_class, .. } => is_class_excluded(elem_class.as_str()),
@@ -464,7 +473,7 @@ fn is_type_excluded(ty: &str, ctx: &mut Context) -> bool {
     }
 }
 
-fn is_method_excluded(method: &ClassMethod, #[allow(unused_variables)] ctx: &mut Context) -> bool {
+fn is_method_excluded(method: &ClassMethod, ctx: &mut Context) -> bool {
     // Currently excluded:
     //
     // * Private virtual methods designed for override; skip for now
@@ -477,7 +486,6 @@ fn is_method_excluded(method: &ClassMethod, #[allow(unused_variables)] ctx: &mut
     //   As such support could be added later (if at all), with possibly safe interfaces (e.g. Vec for void*+size pairs)
 
     // -- FIXME remove when impl complete
-    #[cfg(not(feature = "codegen-full"))]
     if method
         .return_value
         .as_ref()
@@ -502,12 +510,6 @@ fn is_method_excluded(method: &ClassMethod, #[allow(unused_variables)] ctx: &mut
             .map_or(false, |args| args.iter().any(|arg| arg.type_.contains('*')))
 }
 
-#[cfg(feature = "codegen-full")]
-fn is_function_excluded(_function: &UtilityFunction, _ctx: &mut Context) -> bool {
-    false
-}
-
-#[cfg(not(feature = "codegen-full"))]
 fn is_function_excluded(function: &UtilityFunction, ctx: &mut Context) -> bool {
     function
         .return_type
@@ -556,14 +558,18 @@ fn make_method_definition(
     };
 
     let class_name_str = &class_name.godot_ty;
+    // The method bind is looked up once on first call, then cached in a per-method static.
     let init_code = quote! {
-        let __class_name = StringName::from(#class_name_str);
-        let __method_name = StringName::from(#method_name_str);
-        let __method_bind = sys::interface_fn!(classdb_get_method_bind)(
-            __class_name.string_sys(),
-            __method_name.string_sys(),
-            #hash
-        );
+        static __METHOD_BIND: sys::MethodBindCache = sys::MethodBindCache::new();
+        let __method_bind = __METHOD_BIND.get_or_init(|| {
+            let __class_name = StringName::from(#class_name_str);
+            let __method_name = StringName::from(#method_name_str);
+            sys::interface_fn!(classdb_get_method_bind)(
+                __class_name.string_sys(),
+                __method_name.string_sys(),
+                #hash
+            )
+        });
         let __call_fn = sys::interface_fn!(#function_provider);
     };
     let varcall_invocation = quote! {
@@ -604,20 +610,13 @@ fn make_builtin_method_definition(
         make_receiver(method.is_static, method.is_const, quote! { self.sys_ptr });
 
     let return_value = method.return_type.as_deref().map(MethodReturn::from_type);
-    let hash = method.hash;
     let is_varcall = method.is_vararg;
     let variant_ffi = is_varcall.then(VariantFfi::type_ptr);
 
-    let variant_type = &type_info.type_names.sys_variant_type;
+    // Function pointer is resolved once during initialization, see GlobalMethodTable.
+    let table_field = make_builtin_method_ident(&type_info.type_names, method);
     let init_code = quote! {
-        let __variant_type = sys::#variant_type;
-        let __method_name = StringName::from(#method_name_str);
-        let __call_fn = sys::interface_fn!(variant_get_ptr_builtin_method)(
-            __variant_type,
-            __method_name.string_sys(),
-            #hash
-        );
-        let __call_fn = __call_fn.unwrap_unchecked();
+        let __call_fn = sys::builtin_fn!(#table_field);
     };
     let ptrcall_invocation = quote! {
         __call_fn(#receiver_arg, __args_ptr, return_ptr, __args.len() as i32);
@@ -650,7 +649,7 @@ pub(crate) fn make_utility_function_definition(
     let hash = function.hash;
     let variant_ffi = function.is_vararg.then_some(VariantFfi::type_ptr());
     let init_code = quote! {
-        let __function_name = StringName::from(#function_name_str);
+        let __function_name = crate::static_sname!(#function_name_str);
         let __call_fn = sys::interface_fn!(variant_get_ptr_utility_function)(__function_name.string_sys(), #hash);
         let __call_fn = __call_fn.unwrap_unchecked();
     };
@@ -756,6 +755,7 @@ fn make_function_definition(
     if let Some(variant_ffi) = variant_ffi.as_ref() {
         // varcall (using varargs)
         let sys_method = &variant_ffi.sys_method;
+        let explicit_arg_count = arg_exprs.len();
         quote! {
             #vis fn #fn_name( #receiver #( #params, )* varargs: &[Variant]) #return_decl {
                 unsafe {
@@ -765,9 +765,10 @@ fn make_function_definition(
                         #( #arg_exprs ),*
                     ];
 
-                    let mut __args = Vec::with_capacity(__explicit_args.len() + varargs.len());
-                    __args.extend(__explicit_args.iter().map(Variant::#sys_method));
-                    __args.extend(varargs.iter().map(Variant::#sys_method));
+                    // Stays on the stack unless there are more than VARCALL_INLINE_VARARGS varargs.
+                    let __args = sys::VarcallArgs::<_, { #explicit_arg_count + sys::VARCALL_INLINE_VARARGS }>::new(
+                        __explicit_args.iter().chain(varargs).map(Variant::#sys_method)
+                    );
 
                     let __args_ptr = __args.as_ptr();
 
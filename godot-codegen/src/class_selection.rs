@@ -0,0 +1,176 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Decides which engine classes are generated.
+//!
+//! By default, the `codegen-full` feature generates all classes, and without it only [`SELECTED_CLASSES`] are generated.
+//! Setting the environment variable `GODOT_CODEGEN_CLASSES` to the path of an allowlist file restricts generation to
+//! the listed classes in either case. The file contains one Godot class name per line; empty lines and lines starting
+//! with `#` are ignored.
+//!
+//! Whatever the source, the selection always includes [`SELECTED_CLASSES`] (required by godot-core itself), as well
+//! as all base classes of selected classes. Methods whose signatures refer to unselected classes are skipped.
+
+use crate::api_parser::ExtensionApi;
+use crate::SELECTED_CLASSES;
+use std::collections::{HashMap, HashSet};
+use std::path::Path;
+
+/// Environment variable holding the path to the allowlist file.
+pub const CLASS_ALLOWLIST_ENV: &str = "GODOT_CODEGEN_CLASSES";
+
+#[derive(Debug, Default)]
+pub(crate) enum ClassSelection {
+    #[default]
+    All,
+    Only(HashSet<String>),
+}
+
+impl ClassSelection {
+    /// Determines the selection from the environment and enabled features.
+    pub fn from_env(api: &ExtensionApi) -> Self {
+        let listed =
+            std::env::var_os(CLASS_ALLOWLIST_ENV).map(|path| read_allowlist(Path::new(&path)));
+
+        if listed.is_none() && cfg!(feature = "codegen-full") {
+            return Self::All;
+        }
+
+        let roots = SELECTED_CLASSES
+            .iter()
+            .map(|&class| class.to_string())
+            .chain(listed.into_iter().flatten());
+
+        let bases = api
+            .classes
+            .iter()
+            .map(|class| (class.name.as_str(), class.inherits.as_deref()));
+
+        Self::Only(close_over_bases(roots, bases))
+    }
+
+    pub fn contains(&self, class_name: &str) -> bool {
+        match self {
+            Self::All => true,
+            Self::Only(classes) => classes.contains(class_name),
+        }
+    }
+}
+
+/// Regenerate when the selection changes. Only effective when codegen runs inside a build script.
+///
+/// Must be emitted on every run (also when codegen is skipped), as cargo only keeps the directives of the last run.
+pub(crate) fn print_rerun_directives() {
+    println!("cargo:rerun-if-env-changed={CLASS_ALLOWLIST_ENV}");
+
+    if let Some(path) = std::env::var_os(CLASS_ALLOWLIST_ENV) {
+        println!("cargo:rerun-if-changed={}", Path::new(&path).display());
+    }
+}
+
+fn read_allowlist(path: &Path) -> Vec<String> {
+    let contents = std::fs::read_to_string(path).unwrap_or_else(|e| {
+        panic!(
+            "failed to read class allowlist {} (from {CLASS_ALLOWLIST_ENV}): {e}",
+            path.display()
+        )
+    });
+
+    parse_allowlist(&contents)
+}
+
+fn parse_allowlist(contents: &str) -> Vec<String> {
+    contents
+        .lines()
+        .map(str::trim)
+        .filter(|line| !line.is_empty() && !line.starts_with('#'))
+        .map(str::to_string)
+        .collect()
+}
+
+/// Returns `roots` together with all their (transitive) base classes, given `(class, base)` pairs for all classes.
+///
+/// Panics if a root is not a known class.
+fn close_over_bases<'a>(
+    roots: impl Iterator<Item = String>,
+    bases: impl Iterator<Item = (&'a str, Option<&'a str>)>,
+) -> HashSet<String> {
+    let bases: HashMap<&str, Option<&str>> = bases.collect();
+
+    let mut selected = HashSet::new();
+    for root in roots {
+        let mut base = bases.get_key_value(root.as_str()).unwrap_or_else(|| {
+            panic!("class `{root}` from the class selection does not exist in the Godot API")
+        });
+
+        // Walk up the hierarchy, until the top or an already selected class.
+        while selected.insert(base.0.to_string()) {
+            match base.1.and_then(|name| bases.get_key_value(name)) {
+                Some(next) => base = next,
+                None => break,
+            }
+        }
+    }
+
+    selected
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const HIERARCHY: &[(&str, Option<&str>)] = &[
+        ("Object", None),
+        ("Node", Some("Object")),
+        ("CanvasItem", Some("Node")),
+        ("Node2D", Some("CanvasItem")),
+        ("Sprite2D", Some("Node2D")),
+        ("RefCounted", Some("Object")),
+        ("Resource", Some("RefCounted")),
+    ];
+
+    fn select(roots: &[&str]) -> Vec<String> {
+        let roots = roots.iter().map(|root| root.to_string());
+        let mut selected: Vec<_> = close_over_bases(roots, HIERARCHY.iter().copied())
+            .into_iter()
+            .collect();
+
+        selected.sort();
+        selected
+    }
+
+    #[test]
+    fn selection_includes_bases() {
+        assert_eq!(
+            select(&["Sprite2D", "Resource"]),
+            [
+                "CanvasItem",
+                "Node",
+                "Node2D",
+                "Object",
+                "RefCounted",
+                "Resource",
+                "Sprite2D"
+            ]
+        );
+        assert_eq!(select(&["Node", "Node"]), ["Node", "Object"]);
+        assert!(select(&[]).is_empty());
+    }
+
+    #[test]
+    #[should_panic]
+    fn selection_unknown_class() {
+        select(&["NoSuchClass"]);
+    }
+
+    #[test]
+    fn allowlist_parsing() {
+        let contents = "# Server classes\nNode\n\n  Timer  \n# HTTPRequest\n";
+        assert_eq!(parse_allowlist(contents), ["Node", "Timer"]);
+    }
+}
@@ -5,12 +5,14 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+use crate::class_selection::ClassSelection;
 use crate::{ExtensionApi, RustTy, TyName};
 use std::collections::{HashMap, HashSet};
 
 #[derive(Default)]
 pub(crate) struct Context<'a> {
     engine_classes: HashSet<TyName>,
+    class_selection: ClassSelection,
     builtin_types: HashSet<&'a str>,
     singletons: HashSet<&'a str>,
     inheritance_tree: InheritanceTree,
@@ -19,7 +21,10 @@ pub(crate) struct Context<'a> {
 
 impl<'a> Context<'a> {
     pub fn build_from_api(api: &'a ExtensionApi) -> Self {
-        let mut ctx = Context::default();
+        let mut ctx = Context {
+            class_selection: ClassSelection::from_env(api),
+            ..Default::default()
+        };
 
         for class in api.singletons.iter() {
             ctx.singletons.insert(class.name.as_str());
@@ -34,8 +39,7 @@ impl<'a> Context<'a> {
         for class in api.classes.iter() {
             let class_name = TyName::from_godot(&class.name);
 
-            #[cfg(not(feature = "codegen-full"))]
-            if !crate::SELECTED_CLASSES.contains(&class_name.godot_ty.as_str()) {
+            if !ctx.is_class_selected(&class_name.godot_ty) {
                 continue;
             }
 
@@ -55,6 +59,11 @@ impl<'a> Context<'a> {
     //     self.engine_classes.contains(class_name)
     // }
 
+    /// Checks if bindings for this engine class are generated; see [`ClassSelection`].
+    pub fn is_class_selected(&self, class_name: &str) -> bool {
+        self.class_selection.contains(class_name)
+    }
+
     /// Checks if this is a builtin type (not `Object`).
     ///
     /// Note that builtins != variant types.
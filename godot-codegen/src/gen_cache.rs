@@ -0,0 +1,499 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Incremental output of generated files.
+//!
+//! Code is first generated into a staging directory next to the real output directory. The whole staged tree is
+//! formatted, then only files whose formatted contents differ from the existing output are atomically moved into place.
+//! Unchanged files keep their modification time, so cargo does not rebuild dependent crates for them.
+//!
+//! Formatting everything (rather than only files that changed before formatting) keeps the output independent of
+//! earlier runs: rustfmt resolves `mod` declarations to their files, so a `mod.rs` can only be formatted if all its
+//! children are present in the staging tree.
+//!
+//! A manifest in the output directory records a key over all generator inputs (API JSON, `gdextension_interface.h`,
+//! generator binary, features and class selection), plus a content hash per file. If the key matches, generation is
+//! skipped entirely.
+
+use crate::class_selection::{self, CLASS_ALLOWLIST_ENV};
+use std::collections::{BTreeMap, BTreeSet};
+use std::fs;
+use std::io::Write;
+use std::path::{Path, PathBuf};
+
+const MANIFEST_FILE: &str = "codegen-cache.txt";
+
+const INTERFACE_HEADER_PATH: &str =
+    concat!(env!("CARGO_MANIFEST_DIR"), "/input/gdextension_interface.h");
+
+pub(crate) struct GenCache {
+    gen_path: PathBuf,
+    staging_path: PathBuf,
+
+    /// `None` if the inputs could not be fingerprinted; then the cache is never considered up-to-date.
+    key: Option<u64>,
+    previous: Manifest,
+}
+
+/// Staged files, ready to be formatted and committed with [`GenCache::commit()`].
+pub(crate) struct Staged {
+    /// Generated files in the staging directory.
+    files: Vec<PathBuf>,
+}
+
+/// Number of files per outcome of [`GenCache::commit()`].
+pub(crate) struct CommitStats {
+    pub written: usize,
+    pub unchanged: usize,
+    pub removed: usize,
+}
+
+impl GenCache {
+    pub fn open(gen_path: &Path, api_json: &str) -> Self {
+        class_selection::print_rerun_directives();
+
+        let gen_path = gen_path.to_path_buf();
+        let staging_name = match gen_path.file_name() {
+            Some(name) => format!("{}.staging", name.to_string_lossy()),
+            None => panic!("invalid codegen output path {}", gen_path.display()),
+        };
+
+        Self {
+            staging_path: gen_path.with_file_name(staging_name),
+            previous: Manifest::read(&gen_path.join(MANIFEST_FILE)),
+            key: input_key(api_json),
+            gen_path,
+        }
+    }
+
+    /// Whether the previous output was generated from the same inputs, and is still complete.
+    pub fn is_up_to_date(&self) -> bool {
+        self.key.is_some()
+            && self.key == self.previous.key
+            && self
+                .previous
+                .files
+                .keys()
+                .all(|file| self.gen_path.join(file).is_file())
+    }
+
+    /// Creates an empty staging directory and returns its path, to be used as output path by the generators.
+    pub fn begin_staging(&self) -> &Path {
+        let _ = fs::remove_dir_all(&self.staging_path);
+        fs::create_dir_all(&self.staging_path).unwrap_or_else(|e| {
+            panic!(
+                "failed to create staging dir {}: {e}",
+                self.staging_path.display()
+            )
+        });
+
+        &self.staging_path
+    }
+
+    /// Completes the staging tree with `staged_files` (paths inside the staging directory), for formatting.
+    ///
+    /// Rust files in the output directory that are not produced by codegen (bindgen's `gdextension_interface.rs`) are
+    /// copied into the staging tree, so that rustfmt can resolve `mod` declarations referring to them. The copies
+    /// are not committed.
+    pub fn stage(&self, staged_files: Vec<PathBuf>) -> Staged {
+        let generated: BTreeSet<String> = staged_files
+            .iter()
+            .map(|file| self.relative_path(file))
+            .collect();
+
+        for relative in rust_files_in(&self.gen_path) {
+            if generated.contains(&relative) || self.previous.files.contains_key(&relative) {
+                continue;
+            }
+
+            let external = self.gen_path.join(&relative);
+            let copy = self.staging_path.join(&relative);
+            if let Some(parent) = copy.parent() {
+                let _ = fs::create_dir_all(parent);
+            }
+            fs::copy(&external, &copy).unwrap_or_else(|e| {
+                panic!(
+                    "failed to copy {} to {}: {e}",
+                    external.display(),
+                    copy.display()
+                )
+            });
+        }
+
+        Staged {
+            files: staged_files,
+        }
+    }
+
+    /// Moves changed files into the output directory, removes outdated files and writes the manifest.
+    ///
+    /// Expects the staged files to be formatted already; a file is changed if its contents differ from the output.
+    pub fn commit(self, staged: Staged) -> CommitStats {
+        let mut stats = CommitStats {
+            written: 0,
+            unchanged: 0,
+            removed: 0,
+        };
+        let mut files = BTreeMap::new();
+
+        for staged_file in staged.files {
+            let relative = self.relative_path(&staged_file);
+            let target = self.gen_path.join(&relative);
+            let contents = fs::read(&staged_file).unwrap_or_else(|e| {
+                panic!("failed to read staged file {}: {e}", staged_file.display())
+            });
+            files.insert(relative, fnv1a(&[&contents]));
+
+            if fs::read(&target).ok().as_deref() == Some(contents.as_slice()) {
+                stats.unchanged += 1;
+                continue;
+            }
+
+            if let Some(parent) = target.parent() {
+                let _ = fs::create_dir_all(parent);
+            }
+
+            // Rename within the same file system is atomic: readers see either the old or the new file.
+            fs::rename(&staged_file, &target).unwrap_or_else(|e| {
+                panic!(
+                    "failed to move {} to {}: {e}",
+                    staged_file.display(),
+                    target.display()
+                )
+            });
+            stats.written += 1;
+        }
+
+        for outdated in self.previous.files.keys() {
+            if !files.contains_key(outdated)
+                && fs::remove_file(self.gen_path.join(outdated)).is_ok()
+            {
+                stats.removed += 1;
+            }
+        }
+
+        let manifest = Manifest {
+            key: self.key,
+            files,
+        };
+        manifest.write(&self.gen_path.join(MANIFEST_FILE));
+
+        let _ = fs::remove_dir_all(&self.staging_path);
+        stats
+    }
+
+    fn relative_path(&self, staged_file: &Path) -> String {
+        let relative = staged_file
+            .strip_prefix(&self.staging_path)
+            .unwrap_or_else(|_| {
+                panic!(
+                    "generated file {} outside staging dir {}",
+                    staged_file.display(),
+                    self.staging_path.display()
+                )
+            });
+
+        // Normalize separators, so the manifest is the same on all platforms.
+        relative.to_string_lossy().replace('\\', "/")
+    }
+}
+
+impl Staged {
+    /// All generated files; formatting must not be limited to changed ones, see module docs.
+    pub fn files_to_format(&self) -> &[PathBuf] {
+        &self.files
+    }
+}
+
+/// Paths of all `.rs` files below `dir`, relative to it and with `/` separators. Empty if `dir` does not exist.
+fn rust_files_in(dir: &Path) -> Vec<String> {
+    let mut files = vec![];
+    let mut pending = vec![dir.to_path_buf()];
+
+    while let Some(current) = pending.pop() {
+        let entries = match fs::read_dir(&current) {
+            Ok(entries) => entries,
+            Err(_) => continue,
+        };
+
+        for entry in entries.flatten() {
+            let path = entry.path();
+            if path.is_dir() {
+                pending.push(path);
+            } else if path.extension().map_or(false, |ext| ext == "rs") {
+                if let Ok(relative) = path.strip_prefix(dir) {
+                    files.push(relative.to_string_lossy().replace('\\', "/"));
+                }
+            }
+        }
+    }
+
+    files
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Writes `contents` to `path`, unless the file already has exactly these contents. Returns whether it was written.
+///
+/// The file is replaced atomically, by writing a temporary file next to it and renaming it.
+pub fn write_if_changed(path: &Path, contents: &[u8]) -> bool {
+    if fs::read(path).ok().as_deref() == Some(contents) {
+        return false;
+    }
+
+    let mut tmp_name = path.as_os_str().to_owned();
+    tmp_name.push(".tmp");
+    let tmp_path = PathBuf::from(tmp_name);
+
+    fs::write(&tmp_path, contents)
+        .and_then(|()| fs::rename(&tmp_path, path))
+        .unwrap_or_else(|e| panic!("failed to write {}: {e}", path.display()));
+
+    true
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[derive(Default)]
+struct Manifest {
+    key: Option<u64>,
+    files: BTreeMap<String, u64>,
+}
+
+impl Manifest {
+    /// Reads the manifest; a missing or malformed file results in an empty one.
+    fn read(path: &Path) -> Self {
+        fs::read_to_string(path)
+            .ok()
+            .and_then(|text| Self::parse(&text))
+            .unwrap_or_default()
+    }
+
+    fn parse(text: &str) -> Option<Self> {
+        let mut lines = text.lines();
+        let key = lines.next()?.strip_prefix("key ")?;
+        let key = u64::from_str_radix(key, 16).ok();
+
+        let mut files = BTreeMap::new();
+        for line in lines {
+            let (hash, file) = line.split_once(' ')?;
+            files.insert(file.to_string(), u64::from_str_radix(hash, 16).ok()?);
+        }
+
+        Some(Self { key, files })
+    }
+
+    fn write(&self, path: &Path) {
+        let mut text = vec![];
+        match self.key {
+            Some(key) => writeln!(text, "key {key:016x}"),
+            None => writeln!(text, "key none"),
+        }
+        .expect("write to Vec");
+
+        for (file, hash) in self.files.iter() {
+            writeln!(text, "{hash:016x} {file}").expect("write to Vec");
+        }
+
+        write_if_changed(path, &text);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Hashes everything that influences the generated code.
+fn input_key(api_json: &str) -> Option<u64> {
+    let header = fs::read(INTERFACE_HEADER_PATH).ok()?;
+
+    // The build script binary contains the generator; it changes whenever the generator code does.
+    let generator = fs::read(std::env::current_exe().ok()?).ok()?;
+
+    let features = format!(
+        "version={} full={} double={} fmt={}",
+        env!("CARGO_PKG_VERSION"),
+        cfg!(feature = "codegen-full"),
+        cfg!(feature = "double-precision"),
+        cfg!(feature = "codegen-fmt"),
+    );
+
+    let allowlist_path = std::env::var_os(CLASS_ALLOWLIST_ENV);
+    let allowlist = match &allowlist_path {
+        Some(path) => fs::read(path).ok()?,
+        None => vec![],
+    };
+    let allowlist_path = allowlist_path.map(|path| path.to_string_lossy().into_owned());
+
+    Some(fnv1a(&[
+        api_json.as_bytes(),
+        &header,
+        &generator,
+        features.as_bytes(),
+        allowlist_path.unwrap_or_default().as_bytes(),
+        &allowlist,
+    ]))
+}
+
+/// 64-bit FNV-1a hash over several byte strings. Stable across Rust versions, unlike `DefaultHasher`.
+fn fnv1a(parts: &[&[u8]]) -> u64 {
+    const OFFSET_BASIS: u64 = 0xcbf2_9ce4_8422_2325;
+    const PRIME: u64 = 0x0000_0100_0000_01b3;
+
+    let mut hash = OFFSET_BASIS;
+    for part in parts {
+        // Include the length, so that moving bytes between parts changes the hash.
+        for byte in (part.len() as u64).to_le_bytes().iter().chain(part.iter()) {
+            hash ^= *byte as u64;
+            hash = hash.wrapping_mul(PRIME);
+        }
+    }
+    hash
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn temp_dir(name: &str) -> PathBuf {
+        let dir = std::env::temp_dir().join(format!("godot-codegen-{name}-{}", std::process::id()));
+        let _ = fs::remove_dir_all(&dir);
+        fs::create_dir_all(&dir).unwrap();
+        dir
+    }
+
+    fn generate(cache: &GenCache, files: &[(&str, &str)]) -> Vec<PathBuf> {
+        let staging = cache.begin_staging();
+        files
+            .iter()
+            .map(|(name, contents)| {
+                let path = staging.join(name);
+                fs::create_dir_all(path.parent().unwrap()).unwrap();
+                fs::write(&path, contents).unwrap();
+                path
+            })
+            .collect()
+    }
+
+    #[test]
+    fn manifest_roundtrip() {
+        let mut files = BTreeMap::new();
+        files.insert("classes/node.rs".to_string(), 0x1234);
+        files.insert("mod.rs".to_string(), 0xffff_0000_0000_0001);
+
+        let dir = temp_dir("manifest");
+        let path = dir.join(MANIFEST_FILE);
+        Manifest {
+            key: Some(42),
+            files: files.clone(),
+        }
+        .write(&path);
+
+        let read = Manifest::read(&path);
+        assert_eq!(read.key, Some(42));
+        assert_eq!(read.files, files);
+
+        assert!(Manifest::parse("garbage").is_none());
+        let _ = fs::remove_dir_all(dir);
+    }
+
+    #[test]
+    fn commit_writes_only_changes() {
+        let root = temp_dir("commit");
+        let gen_path = root.join("gen");
+
+        let cache = GenCache::open(&gen_path, "{}");
+        assert!(!cache.is_up_to_date());
+        let staged = cache.stage(generate(&cache, &[("a.rs", "a"), ("sub/b.rs", "b")]));
+        assert_eq!(staged.files_to_format().len(), 2);
+        let stats = cache.commit(staged);
+        assert_eq!((stats.written, stats.unchanged, stats.removed), (2, 0, 0));
+
+        let cache = GenCache::open(&gen_path, "{}");
+        if cache.key.is_some() {
+            assert!(cache.is_up_to_date());
+        }
+
+        // Second run with one modified, one unchanged and one removed file.
+        let cache = GenCache::open(&gen_path, "{ changed }");
+        assert!(!cache.is_up_to_date());
+        let staged = cache.stage(generate(&cache, &[("a.rs", "a2")]));
+        assert_eq!(staged.files_to_format().len(), 1);
+        let stats = cache.commit(staged);
+        assert_eq!((stats.written, stats.unchanged, stats.removed), (1, 0, 1));
+
+        assert_eq!(fs::read_to_string(gen_path.join("a.rs")).unwrap(), "a2");
+        assert!(!gen_path.join("sub/b.rs").exists());
+        assert!(!root.join("gen.staging").exists());
+        let _ = fs::remove_dir_all(root);
+    }
+
+    #[test]
+    fn formatted_output_independent_of_previous_run() {
+        if std::process::Command::new("rustfmt")
+            .arg("--version")
+            .output()
+            .is_err()
+        {
+            return;
+        }
+
+        let root = temp_dir("format");
+        let gen_path = root.join("gen");
+
+        // Written outside of codegen, like bindgen's output.
+        fs::create_dir_all(&gen_path).unwrap();
+        fs::write(gen_path.join("external.rs"), "pub struct External;\n").unwrap();
+
+        let files = [
+            ("mod.rs", "pub mod external; pub mod classes;"),
+            ("classes/mod.rs", "pub mod node;  pub mod object;"),
+            ("classes/node.rs", "pub struct Node{ id:i64 }"),
+            ("classes/object.rs", "pub struct Object{ id:i64 }"),
+        ];
+
+        let mut outputs = vec![];
+        for _run in 0..2 {
+            let cache = GenCache::open(&gen_path, "{}");
+            let staged = cache.stage(generate(&cache, &files));
+            crate::rustfmt_if_needed(staged.files_to_format());
+            cache.commit(staged);
+
+            let output: Vec<(&str, Vec<u8>)> = files
+                .iter()
+                .map(|(name, _)| (*name, fs::read(gen_path.join(name)).unwrap()))
+                .collect();
+            outputs.push(output);
+        }
+
+        assert!(outputs[0] == outputs[1], "second run changed the output");
+        assert_eq!(
+            fs::read_to_string(gen_path.join("classes/mod.rs")).unwrap(),
+            "pub mod node;\npub mod object;\n"
+        );
+        assert_eq!(
+            fs::read_to_string(gen_path.join("mod.rs")).unwrap(),
+            "pub mod classes;\npub mod external;\n"
+        );
+        assert_eq!(
+            fs::read_to_string(gen_path.join("external.rs")).unwrap(),
+            "pub struct External;\n"
+        );
+        let _ = fs::remove_dir_all(root);
+    }
+
+    #[test]
+    fn write_if_changed_skips_identical() {
+        let dir = temp_dir("write");
+        let path = dir.join("file.rs");
+
+        assert!(write_if_changed(&path, b"contents"));
+        assert!(!write_if_changed(&path, b"contents"));
+        assert!(write_if_changed(&path, b"other"));
+        assert_eq!(fs::read(&path).unwrap(), b"other");
+        let _ = fs::remove_dir_all(dir);
+    }
+}
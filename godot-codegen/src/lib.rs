@@ -8,7 +8,9 @@
 mod api_parser;
 mod central_generator;
 mod class_generator;
+mod class_selection;
 mod context;
+mod gen_cache;
 mod godot_exe;
 mod godot_version;
 mod special_cases;
@@ -26,6 +28,7 @@ use central_generator::{
 };
 use class_generator::{generate_builtin_class_files, generate_class_files};
 use context::Context;
+use gen_cache::GenCache;
 use util::ident;
 use utilities_generator::generate_utilities_file;
 use watch::StopWatch;
@@ -36,66 +39,124 @@ use quote::{quote, ToTokens};
 use std::path::{Path, PathBuf};
 
 pub fn generate_sys_files(sys_gen_path: &Path) {
-    let mut out_files = vec![];
     let mut watch = StopWatch::start();
+    let json = godot_exe::load_extension_api_json(&mut watch);
+
+    let cache = GenCache::open(sys_gen_path, &json);
+    if cache.is_up_to_date() {
+        watch.record("check_cache");
+        watch.note("generated files", "up to date, codegen skipped".to_string());
+        watch.write_stats_to(&sys_gen_path.join("codegen-stats.txt"));
+        return;
+    }
+
+    let mut out_files = vec![];
+    let staging_path = cache.begin_staging();
 
-    generate_sys_mod_file(sys_gen_path, &mut out_files);
+    generate_sys_mod_file(staging_path, &mut out_files);
 
-    let (api, build_config) = load_extension_api(&mut watch);
+    let (api, build_config) = load_extension_api(&json, &mut watch);
     let mut ctx = Context::build_from_api(&api);
     watch.record("build_context");
 
-    generate_sys_central_file(&api, &mut ctx, build_config, sys_gen_path, &mut out_files);
+    generate_sys_central_file(&api, &mut ctx, build_config, staging_path, &mut out_files);
     watch.record("generate_central_file");
 
-    rustfmt_if_needed(out_files);
-    watch.record("rustfmt");
+    commit_generated_files(cache, out_files, &mut watch);
     watch.write_stats_to(&sys_gen_path.join("codegen-stats.txt"));
 }
 
 pub fn generate_core_files(core_gen_path: &Path) {
-    let mut out_files = vec![];
     let mut watch = StopWatch::start();
+    let json = godot_exe::load_extension_api_json(&mut watch);
+
+    let cache = GenCache::open(core_gen_path, &json);
+    if cache.is_up_to_date() {
+        watch.record("check_cache");
+        watch.note("generated files", "up to date, codegen skipped".to_string());
+        watch.write_stats_to(&core_gen_path.join("codegen-stats.txt"));
+        return;
+    }
+
+    let mut out_files = vec![];
+    let staging_path = cache.begin_staging();
 
-    generate_core_mod_file(core_gen_path, &mut out_files);
+    generate_core_mod_file(staging_path, &mut out_files);
 
-    let (api, build_config) = load_extension_api(&mut watch);
+    let (api, build_config) = load_extension_api(&json, &mut watch);
     let mut ctx = Context::build_from_api(&api);
     watch.record("build_context");
 
-    generate_core_central_file(&api, &mut ctx, build_config, core_gen_path, &mut out_files);
+    generate_core_central_file(&api, &mut ctx, build_config, staging_path, &mut out_files);
     watch.record("generate_central_file");
 
-    generate_utilities_file(&api, &mut ctx, core_gen_path, &mut out_files);
+    generate_utilities_file(&api, &mut ctx, staging_path, &mut out_files);
     watch.record("generate_utilities_file");
 
     // Class files -- currently output in godot-core; could maybe be separated cleaner
-    // Note: deletes entire generated directory!
-    generate_class_files(
+    // Note: clears the staged `classes` directory first.
+    let generated_classes = generate_class_files(
         &api,
         &mut ctx,
         build_config,
-        &core_gen_path.join("classes"),
+        &staging_path.join("classes"),
         &mut out_files,
     );
     watch.record("generate_class_files");
+    watch.note(
+        "engine classes",
+        format!(
+            "{generated_classes} of {} generated ({} skipped)",
+            api.classes.len(),
+            api.classes.len() - generated_classes
+        ),
+    );
 
     generate_builtin_class_files(
         &api,
         &mut ctx,
         build_config,
-        &core_gen_path.join("builtin_classes"),
+        &staging_path.join("builtin_classes"),
         &mut out_files,
     );
     watch.record("generate_builtin_class_files");
 
-    rustfmt_if_needed(out_files);
-    watch.record("rustfmt");
+    commit_generated_files(cache, out_files, &mut watch);
     watch.write_stats_to(&core_gen_path.join("codegen-stats.txt"));
 }
 
+/// Formats the staged files, and moves those that changed since the last run into the output directory.
+fn commit_generated_files(cache: GenCache, out_files: Vec<PathBuf>, watch: &mut StopWatch) {
+    let staged = cache.stage(out_files);
+    watch.record("stage");
+
+    rustfmt_if_needed(staged.files_to_format());
+    watch.record("rustfmt");
+
+    let stats = cache.commit(staged);
+    watch.record("write_files");
+    watch.note(
+        "generated files",
+        format!(
+            "{} written, {} unchanged, {} removed",
+            stats.written, stats.unchanged, stats.removed
+        ),
+    );
+}
+
+/// Writes a file generated outside of codegen (e.g. by bindgen), unless it already has the same contents.
+///
+/// This keeps the modification time of unchanged files, avoiding needless rebuilds.
+pub fn write_if_changed(path: &Path, contents: &str) {
+    gen_cache::write_if_changed(path, contents.as_bytes());
+}
+
 // #[cfg(feature = "codegen-fmt")]
-fn rustfmt_if_needed(out_files: Vec<PathBuf>) {
+fn rustfmt_if_needed(out_files: &[PathBuf]) {
+    if out_files.is_empty() {
+        return;
+    }
+
     println!("Format {} generated files...", out_files.len());
 
     for files in out_files.chunks(20) {
@@ -107,16 +168,25 @@ fn rustfmt_if_needed(out_files: Vec<PathBuf>) {
             process.arg(file);
         }
 
-        process
+        let output = process
             .output()
             .unwrap_or_else(|err| panic!("during godot-rust codegen, rustfmt failed:\n   {err}"));
+
+        // Unformatted output would depend on which files happened to be formatted, so fail loudly.
+        if !output.status.success() {
+            panic!(
+                "during godot-rust codegen, rustfmt exited with {}:\n{}",
+                output.status,
+                String::from_utf8_lossy(&output.stderr)
+            );
+        }
     }
 
     println!("Rustfmt completed.");
 }
 //
 // #[cfg(not(feature = "codegen-fmt"))]
-// fn rustfmt_if_needed(_out_files: Vec<PathBuf>) {}
+// fn rustfmt_if_needed(_out_files: &[PathBuf]) {}
 
 // ----------------------------------------------------------------------------------------------------------------------------------------------
 // Shared utility types
@@ -132,7 +202,6 @@ enum RustTy {
     /// `TypedArray<Gd<PhysicsBody3D>>`
     EngineArray {
         tokens: TokenStream,
-        #[allow(dead_code)] // only read in minimal config
         elem_class: String,
     },
 
@@ -140,7 +209,6 @@ enum RustTy {
     EngineEnum {
         tokens: TokenStream,
         /// `None` for globals
-        #[allow(dead_code)] // only read in minimal config
         surrounding_class: Option<String>,
     },
 
@@ -254,8 +322,7 @@ struct GeneratedBuiltinModule {
 // ----------------------------------------------------------------------------------------------------------------------------------------------
 // Shared config
 
-// Classes for minimal config
-#[cfg(not(feature = "codegen-full"))]
+// Classes for minimal config. Always generated, also with a class allowlist; see class_selection.rs.
 const SELECTED_CLASSES: &[&str] = &[
     "AnimatedSprite2D",
     "Area2D",
@@ -269,6 +336,7 @@ const SELECTED_CLASSES: &[&str] = &[
     "CollisionObject2D",
     "CollisionShape2D",
     "Control",
+    "Engine",
     "FileAccess",
     "HTTPRequest",
     "Image",
@@ -14,6 +14,7 @@ use std::io::Write;
 pub struct StopWatch {
     last_instant: Instant,
     metrics: Vec<Metric>,
+    notes: Vec<(&'static str, String)>,
     lwidth: usize,
 }
 
@@ -22,6 +23,7 @@ impl StopWatch {
         Self {
             last_instant: Instant::now(),
             metrics: vec![],
+            notes: vec![],
             lwidth: 0,
         }
     }
@@ -37,6 +39,12 @@ impl StopWatch {
         });
     }
 
+    /// Adds a line of non-timing information to the stats, e.g. how much was generated.
+    pub fn note(&mut self, what: &'static str, value: String) {
+        self.lwidth = usize::max(self.lwidth, what.len());
+        self.notes.push((what, value));
+    }
+
     pub fn write_stats_to(self, to_file: &Path) {
         let file = File::create(to_file).expect("failed to create stats file");
         let mut writer = BufWriter::new(file);
@@ -59,6 +67,14 @@ impl StopWatch {
         writeln!(&mut writer, "{}", "-".repeat(self.lwidth + rwidth + 5))
             .expect("failed to write to stats file");
         Self::write_metric(&mut writer, &total_metric, self.lwidth, rwidth);
+
+        if !self.notes.is_empty() {
+            writeln!(&mut writer).expect("failed to write to stats file");
+        }
+        for (name, value) in self.notes.iter() {
+            writeln!(&mut writer, "{: >l$}: {value}", name, l = self.lwidth)
+                .expect("failed to write to stats file");
+        }
     }
 
     fn write_metric(writer: &mut BufWriter<File>, metric: &Metric, lwidth: usize, rwidth: usize) {
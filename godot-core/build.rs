@@ -9,9 +9,6 @@ use std::path::Path;
 fn main() {
     let gen_path = Path::new(concat!(env!("CARGO_MANIFEST_DIR"), "/src/gen/"));
 
-    if gen_path.exists() {
-        std::fs::remove_dir_all(gen_path).unwrap_or_else(|e| panic!("failed to delete dir: {e}"));
-    }
-
+    // Not deleted upfront: codegen only rewrites files whose contents changed, to avoid rebuilds.
     godot_codegen::generate_core_files(gen_path);
 }
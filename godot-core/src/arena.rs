@@ -0,0 +1,593 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Bump allocation for short-lived temporaries.
+//!
+//! An [`Arena`] hands out memory from large chunks by advancing a cursor, which is much cheaper than going through
+//! the global allocator for every temporary `Vec` or `Box`. Individual allocations are never freed; instead, all of
+//! them are released at once with [`Arena::reset()`], typically at the end of each frame. The borrow checker ensures
+//! that no [`ArenaBox`] or [`ArenaVec`] outlives a reset.
+//!
+//! Each thread additionally has a _frame arena_, available through [`with_frame_arena()`] and cleared by
+//! [`reset_frame_arena()`].
+//!
+//! ```no_run
+//! use godot::arena::Arena;
+//!
+//! let mut arena = Arena::new();
+//! {
+//!     let mut points = arena.vec_with_capacity(64);
+//!     points.push(1.5);
+//!     points.extend([2.0, 2.5]);
+//!     assert_eq!(points.iter().sum::<f32>(), 6.0);
+//! }
+//!
+//! // At the end of the frame:
+//! arena.reset();
+//! ```
+
+use std::alloc::{self, Layout};
+use std::cell::{Cell, RefCell};
+use std::marker::PhantomData;
+use std::ops::{Deref, DerefMut};
+use std::ptr::{self, NonNull};
+use std::{fmt, mem};
+
+use godot_ffi as sys;
+
+/// Size of the first chunk that an arena allocates. Subsequent chunks double in size.
+const INITIAL_CHUNK_SIZE: usize = 4 * 1024;
+
+/// Alignment requested for chunks from the system allocator. Larger alignments are handled by padding.
+const CHUNK_ALIGN: usize = 16;
+
+/// Where an [`Arena`] obtains its chunks from.
+#[derive(Copy, Clone, Eq, PartialEq, Debug)]
+pub enum ArenaBacking {
+    /// Rust's global allocator.
+    System,
+
+    /// Godot's `mem_alloc`/`mem_free`, so that arena memory shows up in Godot's memory statistics.
+    ///
+    /// Requires the GDExtension interface to be initialized.
+    Godot,
+}
+
+/// Bump allocator, whose allocations are all released together.
+///
+/// See the [module documentation](self) for an overview.
+pub struct Arena {
+    backing: ArenaBacking,
+    chunks: RefCell<Vec<Chunk>>,
+
+    /// Offset of the first free byte in the last chunk.
+    cursor: Cell<usize>,
+
+    /// Bytes handed out since the last reset, including alignment padding.
+    used: Cell<usize>,
+}
+
+impl Arena {
+    /// Creates an empty arena backed by the global allocator. Does not allocate until first used.
+    pub fn new() -> Self {
+        Self::with_backing(ArenaBacking::System)
+    }
+
+    /// Creates an empty arena backed by Godot's allocator. Does not allocate until first used.
+    pub fn with_godot_allocator() -> Self {
+        Self::with_backing(ArenaBacking::Godot)
+    }
+
+    pub fn with_backing(backing: ArenaBacking) -> Self {
+        Self {
+            backing,
+            chunks: RefCell::new(Vec::new()),
+            cursor: Cell::new(0),
+            used: Cell::new(0),
+        }
+    }
+
+    pub fn backing(&self) -> ArenaBacking {
+        self.backing
+    }
+
+    /// Moves `value` into the arena.
+    ///
+    /// The value is dropped together with the returned box; its memory is reclaimed on the next [`reset()`](Self::reset).
+    pub fn alloc<T>(&self, value: T) -> ArenaBox<'_, T> {
+        let ptr = self.alloc_layout(Layout::new::<T>()).cast::<T>();
+
+        // SAFETY: ptr is valid and aligned for a T, and not shared with any other allocation.
+        unsafe { ptr.as_ptr().write(value) };
+
+        ArenaBox {
+            ptr,
+            _marker: PhantomData,
+        }
+    }
+
+    /// Copies `values` into the arena.
+    ///
+    /// Since `T: Copy` values need no drop, the slice can be borrowed for as long as the arena.
+    #[allow(clippy::mut_from_ref)] // every call returns a distinct allocation
+    pub fn alloc_slice_copy<T: Copy>(&self, values: &[T]) -> &mut [T] {
+        let ptr = self.alloc_array::<T>(values.len());
+
+        // SAFETY: ptr is valid for values.len() elements and does not overlap with values.
+        unsafe {
+            ptr::copy_nonoverlapping(values.as_ptr(), ptr.as_ptr(), values.len());
+            std::slice::from_raw_parts_mut(ptr.as_ptr(), values.len())
+        }
+    }
+
+    /// Creates an empty vector in this arena. Does not allocate until the first element is added.
+    pub fn vec<T>(&self) -> ArenaVec<'_, T> {
+        ArenaVec {
+            arena: self,
+            ptr: NonNull::dangling(),
+            len: 0,
+            capacity: if mem::size_of::<T>() == 0 {
+                usize::MAX
+            } else {
+                0
+            },
+        }
+    }
+
+    pub fn vec_with_capacity<T>(&self, capacity: usize) -> ArenaVec<'_, T> {
+        let mut vec = self.vec();
+        vec.reserve(capacity);
+        vec
+    }
+
+    /// Releases all allocations at once.
+    ///
+    /// The largest chunk is kept, so that an arena which is reset every frame stops allocating after a few frames.
+    pub fn reset(&mut self) {
+        let chunks = self.chunks.get_mut();
+        if let Some(largest) = chunks.pop() {
+            for chunk in chunks.drain(..) {
+                chunk.free(self.backing);
+            }
+            chunks.push(largest);
+        }
+
+        self.cursor.set(0);
+        self.used.set(0);
+    }
+
+    /// Number of bytes handed out since the last reset, including alignment padding.
+    pub fn used_bytes(&self) -> usize {
+        self.used.get()
+    }
+
+    /// Number of bytes currently obtained from the backing allocator.
+    pub fn reserved_bytes(&self) -> usize {
+        self.chunks.borrow().iter().map(|chunk| chunk.size).sum()
+    }
+
+    fn alloc_array<T>(&self, len: usize) -> NonNull<T> {
+        let layout = Layout::array::<T>(len).expect("arena allocation size overflows");
+        self.alloc_layout(layout).cast::<T>()
+    }
+
+    fn alloc_layout(&self, layout: Layout) -> NonNull<u8> {
+        if layout.size() == 0 {
+            // Any aligned, non-null address is valid for zero-sized accesses.
+            return unsafe { NonNull::new_unchecked(layout.align() as *mut u8) };
+        }
+
+        if let Some(ptr) = self.try_bump(layout) {
+            return ptr;
+        }
+
+        // Chunks are aligned to CHUNK_ALIGN at most, so reserve room for padding up to the requested alignment.
+        let last_size = self.chunks.borrow().last().map_or(0, |chunk| chunk.size);
+        let size = (last_size * 2)
+            .max(INITIAL_CHUNK_SIZE)
+            .max(layout.size() + layout.align());
+
+        self.chunks
+            .borrow_mut()
+            .push(Chunk::allocate(size, self.backing));
+        self.cursor.set(0);
+
+        self.try_bump(layout)
+            .expect("fresh arena chunk must fit the allocation")
+    }
+
+    fn try_bump(&self, layout: Layout) -> Option<NonNull<u8>> {
+        let chunks = self.chunks.borrow();
+        let chunk = chunks.last()?;
+
+        let base = chunk.ptr.as_ptr() as usize;
+        let cursor = self.cursor.get();
+        let start = (base + cursor + layout.align() - 1) & !(layout.align() - 1);
+        let end = start.checked_add(layout.size())?;
+        if end > base + chunk.size {
+            return None;
+        }
+
+        self.cursor.set(end - base);
+        self.used.set(self.used.get() + (end - base - cursor));
+
+        // SAFETY: start lies within the chunk, which is non-null.
+        Some(unsafe { NonNull::new_unchecked(start as *mut u8) })
+    }
+}
+
+impl Default for Arena {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for Arena {
+    fn drop(&mut self) {
+        for chunk in self.chunks.get_mut().drain(..) {
+            chunk.free(self.backing);
+        }
+    }
+}
+
+impl fmt::Debug for Arena {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("Arena")
+            .field("backing", &self.backing)
+            .field("used_bytes", &self.used_bytes())
+            .field("reserved_bytes", &self.reserved_bytes())
+            .finish()
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Chunk {
+    ptr: NonNull<u8>,
+    size: usize,
+}
+
+impl Chunk {
+    fn allocate(size: usize, backing: ArenaBacking) -> Self {
+        let ptr = match backing {
+            ArenaBacking::System => unsafe { alloc::alloc(Self::system_layout(size)) },
+            ArenaBacking::Godot => unsafe { sys::interface_fn!(mem_alloc)(size as _) as *mut u8 },
+        };
+
+        match NonNull::new(ptr) {
+            Some(ptr) => Self { ptr, size },
+            None => alloc::handle_alloc_error(Self::system_layout(size)),
+        }
+    }
+
+    fn free(self, backing: ArenaBacking) {
+        match backing {
+            ArenaBacking::System => unsafe {
+                alloc::dealloc(self.ptr.as_ptr(), Self::system_layout(self.size))
+            },
+            ArenaBacking::Godot => unsafe {
+                sys::interface_fn!(mem_free)(self.ptr.as_ptr() as *mut _)
+            },
+        }
+    }
+
+    fn system_layout(size: usize) -> Layout {
+        Layout::from_size_align(size, CHUNK_ALIGN).expect("arena chunk size overflows")
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Owning pointer to a value inside an [`Arena`].
+///
+/// Dropping the box drops the value, but its memory is only reclaimed when the arena is reset.
+pub struct ArenaBox<'a, T> {
+    ptr: NonNull<T>,
+    _marker: PhantomData<(&'a Arena, T)>,
+}
+
+impl<'a, T> Deref for ArenaBox<'a, T> {
+    type Target = T;
+
+    fn deref(&self) -> &T {
+        // SAFETY: ptr points to an initialized T, owned by this box.
+        unsafe { self.ptr.as_ref() }
+    }
+}
+
+impl<'a, T> DerefMut for ArenaBox<'a, T> {
+    fn deref_mut(&mut self) -> &mut T {
+        // SAFETY: ptr points to an initialized T, owned by this box.
+        unsafe { self.ptr.as_mut() }
+    }
+}
+
+impl<'a, T> Drop for ArenaBox<'a, T> {
+    fn drop(&mut self) {
+        // SAFETY: the value is initialized and dropped exactly once.
+        unsafe { ptr::drop_in_place(self.ptr.as_ptr()) }
+    }
+}
+
+impl<'a, T: fmt::Debug> fmt::Debug for ArenaBox<'a, T> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        fmt::Debug::fmt(&**self, f)
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Growable vector whose elements live inside an [`Arena`].
+///
+/// Growing moves the elements into a new, larger allocation; the old one is reclaimed when the arena is reset.
+/// Reserve the expected capacity upfront to avoid wasting arena memory.
+pub struct ArenaVec<'a, T> {
+    arena: &'a Arena,
+    ptr: NonNull<T>,
+    len: usize,
+    capacity: usize,
+}
+
+impl<'a, T> ArenaVec<'a, T> {
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    pub fn capacity(&self) -> usize {
+        self.capacity
+    }
+
+    pub fn push(&mut self, value: T) {
+        if self.len == self.capacity {
+            self.reserve(1);
+        }
+
+        // SAFETY: len < capacity, so the slot is allocated and uninitialized.
+        unsafe { self.ptr.as_ptr().add(self.len).write(value) };
+        self.len += 1;
+    }
+
+    pub fn pop(&mut self) -> Option<T> {
+        if self.len == 0 {
+            return None;
+        }
+
+        self.len -= 1;
+
+        // SAFETY: the slot at the old last index is initialized, and no longer part of the vector.
+        Some(unsafe { self.ptr.as_ptr().add(self.len).read() })
+    }
+
+    pub fn clear(&mut self) {
+        let elements = ptr::slice_from_raw_parts_mut(self.ptr.as_ptr(), self.len);
+
+        // Set len first, in case a destructor panics.
+        self.len = 0;
+        unsafe { ptr::drop_in_place(elements) };
+    }
+
+    /// Ensures that at least `additional` more elements fit without reallocating.
+    pub fn reserve(&mut self, additional: usize) {
+        let required = self
+            .len
+            .checked_add(additional)
+            .expect("arena vector capacity overflows");
+
+        if required <= self.capacity {
+            return;
+        }
+
+        let capacity = required.max(self.capacity * 2).max(4);
+        let ptr = self.arena.alloc_array::<T>(capacity);
+
+        // SAFETY: both allocations are valid for len elements and distinct. The old one is left uninitialized.
+        unsafe { ptr::copy_nonoverlapping(self.ptr.as_ptr(), ptr.as_ptr(), self.len) };
+
+        self.ptr = ptr;
+        self.capacity = capacity;
+    }
+
+    pub fn as_slice(&self) -> &[T] {
+        // SAFETY: the first len elements are initialized.
+        unsafe { std::slice::from_raw_parts(self.ptr.as_ptr(), self.len) }
+    }
+
+    pub fn as_mut_slice(&mut self) -> &mut [T] {
+        // SAFETY: the first len elements are initialized.
+        unsafe { std::slice::from_raw_parts_mut(self.ptr.as_ptr(), self.len) }
+    }
+
+    pub fn as_ptr(&self) -> *const T {
+        self.ptr.as_ptr()
+    }
+}
+
+impl<'a, T: Clone> ArenaVec<'a, T> {
+    pub fn extend_from_slice(&mut self, values: &[T]) {
+        self.reserve(values.len());
+        for value in values {
+            self.push(value.clone());
+        }
+    }
+}
+
+impl<'a, T> Deref for ArenaVec<'a, T> {
+    type Target = [T];
+
+    fn deref(&self) -> &[T] {
+        self.as_slice()
+    }
+}
+
+impl<'a, T> DerefMut for ArenaVec<'a, T> {
+    fn deref_mut(&mut self) -> &mut [T] {
+        self.as_mut_slice()
+    }
+}
+
+impl<'a, T> Extend<T> for ArenaVec<'a, T> {
+    fn extend<I: IntoIterator<Item = T>>(&mut self, iter: I) {
+        let iter = iter.into_iter();
+        self.reserve(iter.size_hint().0);
+        for value in iter {
+            self.push(value);
+        }
+    }
+}
+
+impl<'a, T> Drop for ArenaVec<'a, T> {
+    fn drop(&mut self) {
+        self.clear();
+    }
+}
+
+impl<'a, T: fmt::Debug> fmt::Debug for ArenaVec<'a, T> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_list().entries(self.iter()).finish()
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Frame arena
+
+thread_local! {
+    static FRAME_ARENA: RefCell<Arena> = RefCell::new(Arena::new());
+}
+
+/// Runs `f` with this thread's frame arena.
+///
+/// Calls can be nested. Memory allocated during `f` is only reclaimed by [`reset_frame_arena()`], so that repeated
+/// calls during one frame do not interfere with each other.
+pub fn with_frame_arena<R>(f: impl FnOnce(&Arena) -> R) -> R {
+    FRAME_ARENA.with(|arena| f(&arena.borrow()))
+}
+
+/// Releases all memory allocated from this thread's frame arena. Call this once per frame, e.g. at the end of
+/// `process()`.
+///
+/// # Panics
+/// If called from within [`with_frame_arena()`].
+pub fn reset_frame_arena() {
+    FRAME_ARENA.with(|arena| {
+        arena
+            .try_borrow_mut()
+            .expect("reset_frame_arena() must not be called inside with_frame_arena()")
+            .reset()
+    });
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod test {
+    use std::rc::Rc;
+
+    use super::*;
+
+    #[test]
+    fn alloc_respects_alignment() {
+        #[repr(align(64))]
+        struct Aligned(u8);
+
+        let arena = Arena::new();
+        let _byte = arena.alloc(1u8);
+        let aligned = arena.alloc(Aligned(7));
+        let word = arena.alloc(0x1234_5678u32);
+
+        assert_eq!(&*aligned as *const Aligned as usize % 64, 0);
+        assert_eq!(&*word as *const u32 as usize % 4, 0);
+        assert_eq!(aligned.0, 7);
+        assert_eq!(*word, 0x1234_5678);
+    }
+
+    #[test]
+    fn alloc_larger_than_chunk() {
+        let arena = Arena::new();
+        let big = arena.alloc_slice_copy(&[3u64; INITIAL_CHUNK_SIZE]);
+        let small = arena.alloc_slice_copy(&[1u8, 2, 3]);
+
+        assert!(big.iter().all(|&v| v == 3));
+        assert_eq!(small, &[1, 2, 3]);
+    }
+
+    #[test]
+    fn vec_grows_and_keeps_elements() {
+        let arena = Arena::new();
+        let mut vec = arena.vec();
+        for i in 0..1000 {
+            vec.push(i.to_string());
+        }
+
+        assert_eq!(vec.len(), 1000);
+        assert_eq!(vec[999], "999");
+        assert_eq!(vec.pop().as_deref(), Some("999"));
+
+        vec.extend_from_slice(&["a".to_string()]);
+        assert_eq!(vec.last().map(String::as_str), Some("a"));
+    }
+
+    #[test]
+    fn drops_values() {
+        let counter = Rc::new(());
+        let arena = Arena::new();
+        {
+            let _boxed = arena.alloc(counter.clone());
+            let mut vec = arena.vec_with_capacity(2);
+            vec.extend([counter.clone(), counter.clone(), counter.clone()]);
+            assert_eq!(Rc::strong_count(&counter), 5);
+        }
+
+        assert_eq!(Rc::strong_count(&counter), 1);
+    }
+
+    #[test]
+    fn zero_sized() {
+        let arena = Arena::new();
+        let mut vec = arena.vec();
+        for _ in 0..10 {
+            vec.push(());
+        }
+
+        assert_eq!(vec.len(), 10);
+        assert_eq!(arena.reserved_bytes(), 0);
+    }
+
+    #[test]
+    fn reset_keeps_largest_chunk() {
+        let mut arena = Arena::new();
+        for _ in 0..3 {
+            arena.alloc_slice_copy(&[0u8; INITIAL_CHUNK_SIZE]);
+        }
+        assert!(arena.used_bytes() >= 3 * INITIAL_CHUNK_SIZE);
+
+        let largest = arena.chunks.borrow().last().unwrap().size;
+        arena.reset();
+        assert_eq!(arena.used_bytes(), 0);
+        assert_eq!(arena.reserved_bytes(), largest);
+
+        // Reuses the kept chunk.
+        arena.alloc_slice_copy(&[0u8; INITIAL_CHUNK_SIZE]);
+        assert_eq!(arena.reserved_bytes(), largest);
+    }
+
+    #[test]
+    fn frame_arena() {
+        let sum = with_frame_arena(|arena| {
+            let mut values = arena.vec();
+            values.extend(1..=4);
+            with_frame_arena(|nested| *nested.alloc(10)) + values.iter().sum::<i32>()
+        });
+        assert_eq!(sum, 20);
+
+        assert!(with_frame_arena(|arena| arena.used_bytes()) > 0);
+        reset_frame_arena();
+        assert_eq!(with_frame_arena(|arena| arena.used_bytes()), 0);
+    }
+}
@@ -189,6 +189,28 @@ impl<T: VariantMetadata> Array<T> {
         Variant::ptr_from_sys_mut(variant_ptr)
     }
 
+    /// Returns a shared view of the array's elements as variants, without converting them.
+    ///
+    /// Godot stores array elements contiguously, so the slice can be traversed without an FFI
+    /// call per element.
+    ///
+    /// # Safety
+    ///
+    /// Arrays are reference-counted and possibly shared (see [`Share`]). The array must not be
+    /// modified through another reference while the returned slice is live; for example, a
+    /// resize may reallocate the buffer and leave the slice dangling.
+    pub unsafe fn as_variant_slice(&self) -> &[Variant] {
+        let len = self.len();
+        if len == 0 {
+            return &[];
+        }
+
+        let ptr = self.ptr(0);
+        // SAFETY: `ptr` points to the first of `len` contiguous, initialized variants; the caller
+        // guarantees they are not modified while borrowed.
+        unsafe { std::slice::from_raw_parts(ptr, len) }
+    }
+
     #[doc(hidden)]
     pub fn as_inner(&self) -> inner::InnerArray {
         // SAFETY: The memory layout of `TypedArray<T>` does not depend on `T`.
@@ -373,6 +395,20 @@ impl<T: VariantMetadata + FromVariant> Array<T> {
         T::from_variant(variant)
     }
 
+    /// Converts this array to a Rust vector, converting each element from `Variant`.
+    ///
+    /// Performs a single bounds check and then walks the contiguous element buffer, instead of
+    /// looking up each index through Godot.
+    ///
+    /// # Panics
+    ///
+    /// If an element cannot be converted to `T`.
+    pub fn to_vec(&self) -> Vec<T> {
+        // SAFETY: the slice does not outlive this function, which does not modify the array.
+        let variants = unsafe { self.as_variant_slice() };
+        variants.iter().map(T::from_variant).collect()
+    }
+
     /// Returns the first element in the array, or `None` if the array is empty. Equivalent of
     /// `front()` in GDScript.
     pub fn first(&self) -> Option<T> {
@@ -515,6 +551,28 @@ impl<T: VariantMetadata + ToVariant> Array<T> {
         self.as_inner().push_back(value.to_variant());
     }
 
+    /// Appends all elements of `other` at the end of the array.
+    ///
+    /// Resizes the array once and writes the converted elements in place, instead of pushing them
+    /// one by one.
+    pub fn extend_from_slice(&mut self, other: &[T]) {
+        if other.is_empty() {
+            return;
+        }
+
+        let old_len = self.len();
+        self.resize(old_len + other.len());
+
+        let ptr = self.ptr_mut(old_len);
+        for (i, element) in other.iter().enumerate() {
+            // SAFETY: The array now contains `old_len + other.len()` elements, stored contiguously
+            // in memory. Assignment destroys the default value that `resize()` put there.
+            unsafe {
+                *ptr.offset(to_isize(i)) = element.to_variant();
+            }
+        }
+    }
+
     /// Adds an element at the beginning of the array. See also `push`.
     ///
     /// Note: On large arrays, this method is much slower than `push` as it will move all the
@@ -673,18 +731,7 @@ impl<T: VariantMetadata + ToVariant, const N: usize> From<&[T; N]> for Array<T>
 impl<T: VariantMetadata + ToVariant> From<&[T]> for Array<T> {
     fn from(slice: &[T]) -> Self {
         let mut array = Self::new();
-        let len = slice.len();
-        if len == 0 {
-            return array;
-        }
-        array.resize(len);
-        let ptr = array.ptr_mut(0);
-        for (i, element) in slice.iter().enumerate() {
-            // SAFETY: The array contains exactly `len` elements, stored contiguously in memory.
-            unsafe {
-                *ptr.offset(to_isize(i)) = element.to_variant();
-            }
-        }
+        array.extend_from_slice(slice);
         array
     }
 }
@@ -701,12 +748,33 @@ impl<T: VariantMetadata + ToVariant> FromIterator<T> for Array<T> {
 /// Extends a `Array` with the contents of an iterator.
 impl<T: VariantMetadata + ToVariant> Extend<T> for Array<T> {
     fn extend<I: IntoIterator<Item = T>>(&mut self, iter: I) {
-        // Unfortunately the GDExtension API does not offer the equivalent of `Vec::reserve`.
-        // Otherwise we could use it to pre-allocate based on `iter.size_hint()`.
-        //
-        // A faster implementation using `resize()` and direct pointer writes might still be
-        // possible.
-        for item in iter.into_iter() {
+        // The GDExtension API does not offer the equivalent of `Vec::reserve`. Instead, resize
+        // once to the lower bound of `size_hint()` and write those elements in place; any
+        // remaining elements are pushed one by one.
+        let mut iter = iter.into_iter();
+        let (lower, _) = iter.size_hint();
+
+        if lower > 0 {
+            let old_len = self.len();
+            self.resize(old_len + lower);
+
+            let ptr = self.ptr_mut(old_len);
+            let mut written = 0;
+            for item in iter.by_ref().take(lower) {
+                // SAFETY: `written < lower`, and the array contains `old_len + lower` contiguous elements.
+                unsafe {
+                    *ptr.offset(to_isize(written)) = item.to_variant();
+                }
+                written += 1;
+            }
+
+            // Iterators may yield fewer elements than their lower bound claims (although they shouldn't).
+            if written < lower {
+                self.resize(old_len + written);
+            }
+        }
+
+        for item in iter {
             self.push(item);
         }
     }
@@ -715,17 +783,7 @@ impl<T: VariantMetadata + ToVariant> Extend<T> for Array<T> {
 /// Converts this array to a strongly typed Rust vector.
 impl<T: VariantMetadata + FromVariant> From<&Array<T>> for Vec<T> {
     fn from(array: &Array<T>) -> Vec<T> {
-        let len = array.len();
-        let mut vec = Vec::with_capacity(len);
-        let ptr = array.ptr(0);
-        for offset in 0..to_isize(len) {
-            // SAFETY: Arrays are stored contiguously in memory, so we can use pointer arithmetic
-            // instead of going through `array_operator_index_const` for every index.
-            let variant = unsafe { &*ptr.offset(offset) };
-            let element = T::from_variant(variant);
-            vec.push(element);
-        }
-        vec
+        array.to_vec()
     }
 }
 
@@ -12,6 +12,7 @@ use sys::{ffi_methods, GodotFfi};
 
 use super::glam_helpers::{GlamConv, GlamType};
 use super::real_consts::FRAC_PI_2;
+use super::soa::{self, Vector3x4};
 use super::{math::*, Quaternion, Vector3};
 use super::{real, RMat3, RQuat, RVec2, RVec3};
 
@@ -404,6 +405,23 @@ impl Basis {
         result
     }
 
+    /// Multiplies all `vectors` in place, with the same result as `*vector = self * *vector` for each element.
+    ///
+    /// Vectors are processed several at a time, which is faster than multiplying them one by one.
+    pub fn mul_slice(&self, vectors: &mut [Vector3]) {
+        let [row_x, row_y, row_z] = self.rows;
+
+        soa::map_in_place(
+            vectors,
+            |v| Vector3x4 {
+                x: v.dot_splat(row_x),
+                y: v.dot_splat(row_y),
+                z: v.dot_splat(row_z),
+            },
+            |v| *self * v,
+        );
+    }
+
     /// Transposed dot product with the X axis (column) of the matrix.
     ///
     /// _Godot equivalent: `Basis.tdotx()`_
@@ -6,13 +6,14 @@
 
 use godot_ffi as sys;
 
-use crate::builtin::{inner, FromVariant, ToVariant, Variant};
+use crate::builtin::meta::VariantMetadata;
+use crate::builtin::{inner, FromVariant, ToVariant, Variant, VariantConversionError};
 use crate::obj::Share;
 use std::fmt;
 use std::marker::PhantomData;
 use std::ptr::addr_of_mut;
 use sys::types::OpaqueDictionary;
-use sys::{ffi_methods, interface_fn, GodotFfi};
+use sys::{ffi_methods, interface_fn, GodotFfi, VariantType};
 
 use super::VariantArray;
 
@@ -102,12 +103,7 @@ impl Dictionary {
     /// Note that `NIL` values are returned as `Some(Variant::nil())`, while absent values are returned as `None`.
     /// If you want to treat both as `NIL`, use [`Self::get_or_nil`].
     pub fn get<K: ToVariant>(&self, key: K) -> Option<Variant> {
-        let key = key.to_variant();
-        if !self.contains_key(key.clone()) {
-            return None;
-        }
-
-        Some(self.get_or_nil(key))
+        self.get_keyed(&key.to_variant())
     }
 
     /// Returns the value at the key in the dictionary, or `NIL` otherwise.
@@ -219,11 +215,66 @@ impl Dictionary {
         Keys::new(self)
     }
 
+    /// Returns all key-value pairs of the dictionary, in insertion order.
+    ///
+    /// Much faster than collecting [`Self::iter_shared()`] for large dictionaries: keys and values are fetched with
+    /// one call each ([`Self::keys_array()`], [`Self::values_array()`]), instead of a Godot iteration step and a
+    /// hashed lookup per entry.
+    pub fn to_pairs(&self) -> Vec<(Variant, Variant)> {
+        let mut pairs = Vec::with_capacity(self.len());
+        self.for_each(|key, value| pairs.push((key.clone(), value.clone())));
+        pairs
+    }
+
+    /// Calls `f` for each key-value pair of the dictionary, in insertion order.
+    ///
+    /// Like [`Self::to_pairs()`], this takes a snapshot of keys and values with one call each, and passes references
+    /// into them to `f`, without copying each entry. Modifications to the dictionary during the call are not
+    /// reflected in the snapshot.
+    pub fn for_each(&self, mut f: impl FnMut(&Variant, &Variant)) {
+        let keys = self.keys_array();
+        let values = self.values_array();
+
+        // SAFETY: `keys` and `values` are new arrays that are not shared with anyone else.
+        let (keys, values) = unsafe { (keys.as_variant_slice(), values.as_variant_slice()) };
+        debug_assert_eq!(keys.len(), values.len());
+
+        for (key, value) in keys.iter().zip(values) {
+            f(key, value);
+        }
+    }
+
     #[doc(hidden)]
     pub fn as_inner(&self) -> inner::InnerDictionary {
         inner::InnerDictionary::from_outer(self)
     }
 
+    /// Returns a copy of the value of an existing key, or `None` if the key is absent.
+    ///
+    /// Unlike `contains_key()` followed by an index operation, this hashes the key only once.
+    fn get_keyed(&self, key: &Variant) -> Option<Variant> {
+        // Godot reports absent keys only through the Variant API; the conversion just increments the refcount.
+        let dictionary = self.to_variant();
+        let mut valid: u8 = 0;
+
+        let value = unsafe {
+            Variant::from_var_sys_init(|value_ptr| {
+                interface_fn!(variant_get_keyed)(
+                    dictionary.var_sys_const(),
+                    key.var_sys_const(),
+                    value_ptr,
+                    addr_of_mut!(valid),
+                );
+            })
+        };
+
+        if super::u8_to_bool(valid) {
+            Some(value)
+        } else {
+            None
+        }
+    }
+
     /// Get the pointer corresponding to the given key in the dictionary.
     ///
     /// If there exists no value at the given key, a `NIL` variant will be created.
@@ -326,6 +377,8 @@ impl<K: ToVariant, V: ToVariant> FromIterator<(K, V)> for Dictionary {
 struct DictionaryIter<'a> {
     last_key: Option<Variant>,
     dictionary: &'a Dictionary,
+    // Converted once, instead of for every iteration step.
+    dictionary_variant: Variant,
     is_first: bool,
 }
 
@@ -334,6 +387,7 @@ impl<'a> DictionaryIter<'a> {
         Self {
             last_key: None,
             dictionary,
+            dictionary_variant: dictionary.to_variant(),
             is_first: true,
         }
     }
@@ -341,9 +395,9 @@ impl<'a> DictionaryIter<'a> {
     fn next_key(&mut self) -> Option<Variant> {
         let new_key = if self.is_first {
             self.is_first = false;
-            Self::call_init(self.dictionary)
+            Self::call_init(&self.dictionary_variant)
         } else {
-            Self::call_next(self.dictionary, self.last_key.take()?)
+            Self::call_next(&self.dictionary_variant, self.last_key.take()?)
         };
 
         self.last_key = new_key.clone();
@@ -360,18 +414,18 @@ impl<'a> DictionaryIter<'a> {
         Some((key, value))
     }
 
-    fn call_init(dictionary: &Dictionary) -> Option<Variant> {
+    fn call_init(dictionary: &Variant) -> Option<Variant> {
         // SAFETY:
-        // `dictionary` is a valid `Dictionary` since we have a reference to it,
+        // `dictionary` is a valid `Dictionary` variant since we have a reference to it,
         //    so this will call the implementation for dictionaries.
         // `variant` is an initialized and valid `Variant`.
         let variant: Variant = Variant::nil();
         unsafe { Self::ffi_iterate(interface_fn!(variant_iter_init), dictionary, variant) }
     }
 
-    fn call_next(dictionary: &Dictionary, last_key: Variant) -> Option<Variant> {
+    fn call_next(dictionary: &Variant, last_key: Variant) -> Option<Variant> {
         // SAFETY:
-        // `dictionary` is a valid `Dictionary` since we have a reference to it,
+        // `dictionary` is a valid `Dictionary` variant since we have a reference to it,
         //    so this will call the implementation for dictionaries.
         // `last_key` is an initialized and valid `Variant`, since we own a copy of it.
         unsafe { Self::ffi_iterate(interface_fn!(variant_iter_next), dictionary, last_key) }
@@ -387,10 +441,9 @@ impl<'a> DictionaryIter<'a> {
             sys::GDExtensionVariantPtr,
             *mut sys::GDExtensionBool,
         ) -> sys::GDExtensionBool,
-        dictionary: &Dictionary,
+        dictionary: &Variant,
         next_value: Variant,
     ) -> Option<Variant> {
-        let dictionary = dictionary.to_variant();
         let mut valid: u8 = 0;
 
         let has_next = iter_fn(
@@ -485,29 +538,104 @@ impl<'a> Iterator for Keys<'a> {
 /// key-value pair into a typed `(K, V)`.
 ///
 /// See [Dictionary::iter_shared()] for more information about iteration over dictionaries.
+///
+/// If created from an iterator that has not yet been advanced, this takes a snapshot of the dictionary's keys and
+/// values, and converts them in chunks directly from the snapshot's buffers.
 pub struct TypedIter<'a, K, V> {
     iter: DictionaryIter<'a>,
-    _k: PhantomData<K>,
-    _v: PhantomData<V>,
+    snapshot: Option<Snapshot>,
+    chunk: std::vec::IntoIter<(K, V)>,
+}
+
+/// Key-value pairs converted at once by [`TypedIter`].
+const TYPED_ITER_CHUNK_SIZE: usize = 64;
+
+/// Keys and values of a dictionary, fetched with one call each.
+struct Snapshot {
+    keys: VariantArray,
+    values: VariantArray,
+    next_idx: usize,
 }
 
 impl<'a, K, V> TypedIter<'a, K, V> {
     fn from_untyped(value: Iter<'a>) -> Self {
+        let iter = value.iter;
+        let snapshot = iter.is_first.then(|| Snapshot {
+            keys: iter.dictionary.keys_array(),
+            values: iter.dictionary.values_array(),
+            next_idx: 0,
+        });
+
         Self {
-            iter: value.iter,
-            _k: PhantomData,
-            _v: PhantomData,
+            iter,
+            snapshot,
+            chunk: Vec::new().into_iter(),
         }
     }
 }
 
+impl<'a, K: FromVariant, V: FromVariant> TypedIter<'a, K, V> {
+    /// Converts the next chunk of pairs from the snapshot. Returns false if there are none left.
+    fn refill_chunk(snapshot: &mut Snapshot, chunk: &mut std::vec::IntoIter<(K, V)>) -> bool {
+        // SAFETY: the snapshot arrays are owned by this iterator and never shared.
+        let (keys, values) = unsafe {
+            (
+                snapshot.keys.as_variant_slice(),
+                snapshot.values.as_variant_slice(),
+            )
+        };
+
+        let begin = snapshot.next_idx;
+        let end = keys.len().min(begin + TYPED_ITER_CHUNK_SIZE);
+        if begin >= end {
+            return false;
+        }
+
+        snapshot.next_idx = end;
+        *chunk = keys[begin..end]
+            .iter()
+            .zip(&values[begin..end])
+            .map(|(key, value)| (K::from_variant(key), V::from_variant(value)))
+            .collect::<Vec<_>>()
+            .into_iter();
+
+        true
+    }
+}
+
 impl<'a, K: FromVariant, V: FromVariant> Iterator for TypedIter<'a, K, V> {
     type Item = (K, V);
 
     fn next(&mut self) -> Option<Self::Item> {
-        self.iter
-            .next_key_value()
-            .map(|(key, value)| (K::from_variant(&key), V::from_variant(&value)))
+        let snapshot = match &mut self.snapshot {
+            Some(snapshot) => snapshot,
+            None => {
+                return self
+                    .iter
+                    .next_key_value()
+                    .map(|(key, value)| (K::from_variant(&key), V::from_variant(&value)))
+            }
+        };
+
+        if let Some(pair) = self.chunk.next() {
+            return Some(pair);
+        }
+
+        if Self::refill_chunk(snapshot, &mut self.chunk) {
+            self.chunk.next()
+        } else {
+            None
+        }
+    }
+
+    fn size_hint(&self) -> (usize, Option<usize>) {
+        match &self.snapshot {
+            Some(snapshot) => {
+                let remaining = self.chunk.len() + (snapshot.keys.len() - snapshot.next_idx);
+                (remaining, Some(remaining))
+            }
+            None => (0, None),
+        }
     }
 }
 
@@ -540,6 +668,295 @@ impl<'a, K: FromVariant> Iterator for TypedKeys<'a, K> {
 
 // ----------------------------------------------------------------------------------------------------------------------------------------------
 
+/// A [`Dictionary`] whose keys are all of type `K` and values of type `V`.
+///
+/// Godot has no runtime type for dictionary entries, so the types are enforced on the Rust side: elements are
+/// converted with the `K` and `V` impls of [`ToVariant`] and [`FromVariant`], chosen at compile time. Values are
+/// converted straight from the dictionary's storage, without an intermediate `Variant` copy.
+///
+/// Converting an untyped `Dictionary` (e.g. through [`FromVariant`]) checks all entries once.
+///
+/// # Thread safety
+///
+/// The same principles apply as for [`VariantArray`]. Consult its documentation for details.
+#[repr(transparent)]
+pub struct TypedDictionary<K: VariantMetadata, V: VariantMetadata> {
+    dict: Dictionary,
+    _phantom: PhantomData<(K, V)>,
+}
+
+impl<K: VariantMetadata, V: VariantMetadata> TypedDictionary<K, V> {
+    /// Constructs an empty `TypedDictionary`.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Wraps an untyped dictionary, without checking its entries.
+    fn from_untyped_unchecked(dict: Dictionary) -> Self {
+        Self {
+            dict,
+            _phantom: PhantomData,
+        }
+    }
+
+    /// Returns the number of entries in the dictionary.
+    pub fn len(&self) -> usize {
+        self.dict.len()
+    }
+
+    /// Returns true if the dictionary is empty.
+    pub fn is_empty(&self) -> bool {
+        self.dict.is_empty()
+    }
+
+    /// Removes all key-value pairs from the dictionary.
+    pub fn clear(&mut self) {
+        self.dict.clear()
+    }
+
+    /// Returns a 32-bit integer hash value representing the dictionary and its contents.
+    pub fn hash(&self) -> u32 {
+        self.dict.hash()
+    }
+
+    /// Returns a shallow copy of the dictionary. See [`Dictionary::duplicate_shallow()`].
+    pub fn duplicate_shallow(&self) -> Self {
+        Self::from_untyped_unchecked(self.dict.duplicate_shallow())
+    }
+
+    /// Returns a deep copy of the dictionary. See [`Dictionary::duplicate_deep()`].
+    pub fn duplicate_deep(&self) -> Self {
+        Self::from_untyped_unchecked(self.dict.duplicate_deep())
+    }
+
+    /// Returns the underlying untyped dictionary.
+    pub fn as_untyped(&self) -> &Dictionary {
+        &self.dict
+    }
+
+    /// Converts into the underlying untyped dictionary.
+    pub fn into_untyped(self) -> Dictionary {
+        self.dict
+    }
+}
+
+impl<K, V> TypedDictionary<K, V>
+where
+    K: VariantMetadata + ToVariant,
+    V: VariantMetadata,
+{
+    /// Returns `true` if the dictionary contains the given key.
+    ///
+    /// _Godot equivalent: `has`_
+    pub fn contains_key(&self, key: &K) -> bool {
+        self.dict.contains_key(key.to_variant())
+    }
+}
+
+impl<K, V> TypedDictionary<K, V>
+where
+    K: VariantMetadata + ToVariant,
+    V: VariantMetadata + FromVariant,
+{
+    /// Returns the value for the given key, or `None` if the key is absent.
+    ///
+    /// # Panics
+    /// If the stored value cannot be converted to `V`. This can only happen if the dictionary was modified through
+    /// an untyped reference.
+    pub fn get(&self, key: &K) -> Option<V> {
+        let value = self.dict.get_keyed(&key.to_variant())?;
+        Some(V::from_variant(&value))
+    }
+
+    /// Removes a key from the dictionary, and returns its value if the key was present.
+    ///
+    /// _Godot equivalent: `erase`_
+    pub fn remove(&mut self, key: &K) -> Option<V> {
+        let key = key.to_variant();
+        let old_value = self
+            .dict
+            .get_keyed(&key)
+            .map(|value| V::from_variant(&value));
+
+        if old_value.is_some() {
+            self.dict.as_inner().erase(key);
+        }
+        old_value
+    }
+}
+
+impl<K, V> TypedDictionary<K, V>
+where
+    K: VariantMetadata + ToVariant,
+    V: VariantMetadata + ToVariant + FromVariant,
+{
+    /// Insert a value at the given key, returning the previous value for that key (if available).
+    ///
+    /// If you don't need the previous value, use [`Self::set`] instead.
+    pub fn insert(&mut self, key: K, value: V) -> Option<V> {
+        let key = key.to_variant();
+        let old_value = self
+            .dict
+            .get_keyed(&key)
+            .map(|value| V::from_variant(&value));
+
+        self.dict.set(key, value);
+        old_value
+    }
+}
+
+impl<K, V> TypedDictionary<K, V>
+where
+    K: VariantMetadata + ToVariant,
+    V: VariantMetadata + ToVariant,
+{
+    /// Set a key to a given value.
+    ///
+    /// _Godot equivalent: `dict[key] = value`_
+    pub fn set(&mut self, key: K, value: V) {
+        self.dict.set(key, value)
+    }
+}
+
+impl<K, V> TypedDictionary<K, V>
+where
+    K: VariantMetadata + FromVariant,
+    V: VariantMetadata + FromVariant,
+{
+    /// Returns an iterator over the key-value pairs, converted to `(K, V)`.
+    ///
+    /// See [`Dictionary::iter_shared()`] for more information about iteration over dictionaries.
+    pub fn iter_shared(&self) -> TypedIter<'_, K, V> {
+        self.dict.iter_shared().typed()
+    }
+
+    /// Returns an iterator over the keys, converted to `K`.
+    ///
+    /// See [`Dictionary::keys_shared()`] for more information about iteration over dictionaries.
+    pub fn keys_shared(&self) -> TypedKeys<'_, K> {
+        self.dict.keys_shared().typed()
+    }
+
+    /// Returns all key-value pairs, in insertion order. See [`Dictionary::to_pairs()`].
+    pub fn to_pairs(&self) -> Vec<(K, V)> {
+        let mut pairs = Vec::with_capacity(self.len());
+        self.dict.for_each(|key, value| {
+            pairs.push((K::from_variant(key), V::from_variant(value)));
+        });
+        pairs
+    }
+
+    /// Wraps an untyped dictionary, after checking that all keys convert to `K` and all values to `V`.
+    pub fn try_from_untyped(dict: Dictionary) -> Result<Self, VariantConversionError> {
+        let mut result = Ok(());
+        dict.for_each(|key, value| {
+            if result.is_ok() {
+                result = K::try_from_variant(key)
+                    .and_then(|_| V::try_from_variant(value))
+                    .map(|_| ());
+            }
+        });
+
+        result.map(|()| Self::from_untyped_unchecked(dict))
+    }
+}
+
+impl<K: VariantMetadata, V: VariantMetadata> GodotFfi for TypedDictionary<K, V> {
+    // Same representation as `Dictionary`. Like `Array<T>`, ptrcalls trust the declared type.
+    unsafe fn from_sys(ptr: sys::GDExtensionTypePtr) -> Self {
+        Self::from_untyped_unchecked(Dictionary::from_sys(ptr))
+    }
+
+    unsafe fn from_sys_init(init_fn: impl FnOnce(sys::GDExtensionTypePtr)) -> Self {
+        Self::from_untyped_unchecked(Dictionary::from_sys_init(init_fn))
+    }
+
+    unsafe fn from_sys_init_default(init_fn: impl FnOnce(sys::GDExtensionTypePtr)) -> Self {
+        Self::from_untyped_unchecked(Dictionary::from_sys_init_default(init_fn))
+    }
+
+    fn sys(&self) -> sys::GDExtensionTypePtr {
+        self.dict.sys()
+    }
+
+    unsafe fn write_sys(&self, dst: sys::GDExtensionTypePtr) {
+        self.dict.write_sys(dst)
+    }
+}
+
+impl<K: VariantMetadata, V: VariantMetadata> Default for TypedDictionary<K, V> {
+    fn default() -> Self {
+        Self::from_untyped_unchecked(Dictionary::new())
+    }
+}
+
+impl<K: VariantMetadata, V: VariantMetadata> PartialEq for TypedDictionary<K, V> {
+    fn eq(&self, other: &Self) -> bool {
+        self.dict == other.dict
+    }
+}
+
+impl<K: VariantMetadata, V: VariantMetadata> fmt::Debug for TypedDictionary<K, V> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        fmt::Debug::fmt(&self.dict, f)
+    }
+}
+
+/// Creates a new reference to the data in this dictionary. Changes to the original dictionary will be
+/// reflected in the copy and vice versa.
+impl<K: VariantMetadata, V: VariantMetadata> Share for TypedDictionary<K, V> {
+    fn share(&self) -> Self {
+        Self::from_untyped_unchecked(self.dict.share())
+    }
+}
+
+impl<K: VariantMetadata, V: VariantMetadata> VariantMetadata for TypedDictionary<K, V> {
+    fn variant_type() -> VariantType {
+        VariantType::Dictionary
+    }
+}
+
+impl<K: VariantMetadata, V: VariantMetadata> ToVariant for TypedDictionary<K, V> {
+    fn to_variant(&self) -> Variant {
+        self.dict.to_variant()
+    }
+}
+
+impl<K, V> FromVariant for TypedDictionary<K, V>
+where
+    K: VariantMetadata + FromVariant,
+    V: VariantMetadata + FromVariant,
+{
+    fn try_from_variant(variant: &Variant) -> Result<Self, VariantConversionError> {
+        let dict = Dictionary::try_from_variant(variant)?;
+        Self::try_from_untyped(dict)
+    }
+}
+
+impl<K, V> Extend<(K, V)> for TypedDictionary<K, V>
+where
+    K: VariantMetadata + ToVariant,
+    V: VariantMetadata + ToVariant,
+{
+    fn extend<I: IntoIterator<Item = (K, V)>>(&mut self, iter: I) {
+        self.dict.extend(iter)
+    }
+}
+
+impl<K, V> FromIterator<(K, V)> for TypedDictionary<K, V>
+where
+    K: VariantMetadata + ToVariant,
+    V: VariantMetadata + ToVariant,
+{
+    fn from_iter<I: IntoIterator<Item = (K, V)>>(iter: I) -> Self {
+        let mut dict = Self::new();
+        dict.extend(iter);
+        dict
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
 /// Constructs [`Dictionary`] literals, close to Godot's own syntax.
 ///
 /// Any value can be used as a key, but to use an expression you need to surround it
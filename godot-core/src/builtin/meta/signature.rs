@@ -17,22 +17,24 @@ pub trait SignatureTuple {
     fn property_info(index: i32, param_name: &str) -> PropertyInfo;
     fn param_metadata(index: i32) -> sys::GDExtensionClassMethodArgumentMetadata;
 
-    unsafe fn varcall<C: GodotClass>(
+    // `func` receives the instance pointer, and is responsible for borrowing the user instance from storage.
+    // That allows `&self` and `&mut self` methods to use different borrows.
+    unsafe fn varcall(
         instance_ptr: sys::GDExtensionClassInstancePtr,
         args_ptr: *const sys::GDExtensionConstVariantPtr,
         ret: sys::GDExtensionVariantPtr,
         err: *mut sys::GDExtensionCallError,
-        func: fn(&mut C, Self::Params) -> Self::Ret,
+        func: fn(sys::GDExtensionClassInstancePtr, Self::Params) -> Self::Ret,
         method_name: &str,
     );
 
     // Note: this method imposes extra bounds on GodotFfi, which may not be implemented for user types.
     // We could fall back to varcalls in such cases, and not require GodotFfi categorically.
-    unsafe fn ptrcall<C: GodotClass>(
+    unsafe fn ptrcall(
         instance_ptr: sys::GDExtensionClassInstancePtr,
         args_ptr: *const sys::GDExtensionConstTypePtr,
         ret: sys::GDExtensionTypePtr,
-        func: fn(&mut C, Self::Params) -> Self::Ret,
+        func: fn(sys::GDExtensionClassInstancePtr, Self::Params) -> Self::Ret,
         method_name: &str,
     );
 }
@@ -55,7 +57,6 @@ pub trait SignatureTuple {
 //
 use crate::builtin::meta::*;
 use crate::builtin::{FromVariant, ToVariant, Variant};
-use crate::obj::GodotClass;
 
 macro_rules! impl_signature_for_tuple {
     (
@@ -105,22 +106,18 @@ macro_rules! impl_signature_for_tuple {
             }
 
             #[inline]
-            unsafe fn varcall<C : GodotClass>(
+            unsafe fn varcall(
 				instance_ptr: sys::GDExtensionClassInstancePtr,
                 args_ptr: *const sys::GDExtensionConstVariantPtr,
                 ret: sys::GDExtensionVariantPtr,
                 err: *mut sys::GDExtensionCallError,
-                func: fn(&mut C, Self::Params) -> Self::Ret,
+                func: fn(sys::GDExtensionClassInstancePtr, Self::Params) -> Self::Ret,
                 method_name: &str,
             ) {
-    	        $crate::out!("varcall: {}", method_name);
-
-                let storage = unsafe { crate::private::as_storage::<C>(instance_ptr) };
-                let mut instance = storage.get_mut();
-
                 let args = ( $(
                     {
-                        let variant = unsafe { &*(*args_ptr.offset($n) as *mut Variant) }; // TODO from_var_sys
+                        // Borrowed from Godot; each parameter type converts straight from it, without copying the Variant.
+                        let variant = unsafe { Variant::borrow_var_sys(*args_ptr.offset($n)) };
                         let arg = <$Pn as FromVariant>::try_from_variant(variant)
                             .unwrap_or_else(|e| param_error::<$Pn>(method_name, $n, variant));
 
@@ -128,27 +125,23 @@ macro_rules! impl_signature_for_tuple {
                     },
                 )* );
 
-				let ret_val = func(&mut *instance, args);
-                let ret_variant = <$R as ToVariant>::to_variant(&ret_val); // TODO write_sys
+				let ret_val = func(instance_ptr, args);
+
+                // Godot passes a nil variant as return slot, so it can be overwritten without destruction.
 				unsafe {
-                    *(ret as *mut Variant) = ret_variant;
+                    <$R as ToVariant>::move_into_var_sys(ret_val, ret);
                     (*err).error = sys::GDEXTENSION_CALL_OK;
                 }
             }
 
             #[inline]
-            unsafe fn ptrcall<C : GodotClass>(
+            unsafe fn ptrcall(
 				instance_ptr: sys::GDExtensionClassInstancePtr,
                 args_ptr: *const sys::GDExtensionConstTypePtr,
                 ret: sys::GDExtensionTypePtr,
-                func: fn(&mut C, Self::Params) -> Self::Ret,
+                func: fn(sys::GDExtensionClassInstancePtr, Self::Params) -> Self::Ret,
                 method_name: &str,
             ) {
-                $crate::out!("ptrcall: {}", method_name);
-
-                let storage = unsafe { crate::private::as_storage::<C>(instance_ptr) };
-                let mut instance = storage.get_mut();
-
 				let args = ( $(
                     unsafe {
                         <$Pn as sys::GodotFuncMarshal>::try_from_sys(
@@ -158,7 +151,7 @@ macro_rules! impl_signature_for_tuple {
                         .unwrap_or_else(|e| param_error::<$Pn>(method_name, $n, &e)),
                 )* );
 
-                let ret_val = func(&mut *instance, args);
+                let ret_val = func(instance_ptr, args);
 				unsafe { <$R as sys::GodotFuncMarshal>::try_write_sys(&ret_val, ret) }
                     .unwrap_or_else(|e| return_error::<$R>(method_name, &e));
 
@@ -33,12 +33,12 @@
 //!   overloading would become impossible](https://github.com/kvark/mint/issues/75).
 
 // Re-export macros.
-pub use crate::{array, dict, varray};
+pub use crate::{array, dict, static_sname, varray};
 
 pub use array_inner::{Array, VariantArray};
 pub use basis::*;
 pub use color::*;
-pub use dictionary_inner::Dictionary;
+pub use dictionary_inner::{Dictionary, TypedDictionary};
 pub use math::*;
 pub use node_path::*;
 pub use others::*;
@@ -92,6 +92,7 @@ mod others;
 mod packed_array;
 mod projection;
 mod quaternion;
+mod soa;
 mod string;
 mod string_chars;
 mod string_name;
@@ -84,19 +84,43 @@ macro_rules! impl_packed_array {
 
             /// Converts this array to a Rust vector, making a copy of its contents.
             pub fn to_vec(&self) -> Vec<$Element> {
+                // For `Copy` element types, this is a single memcpy. `GodotString` is refcounted
+                // and is cloned element-wise.
+                self.as_slice().to_vec()
+            }
+
+            /// Returns a shared view of the array's contents, without copying.
+            ///
+            /// Packed arrays are stored contiguously in memory, so the returned slice can be
+            /// processed with regular Rust (or SIMD) code without further FFI calls.
+            pub fn as_slice(&self) -> &[$Element] {
                 let len = self.len();
-                let mut vec = Vec::with_capacity(len);
+                if len == 0 {
+                    return &[];
+                }
+
                 let ptr = self.ptr(0);
-                for offset in 0..to_isize(len) {
-                    // SAFETY: Packed arrays are stored contiguously in memory, so we can use
-                    // pointer arithmetic instead of going through `$operator_index_const` for
-                    // every index.
-                    // Note that we do need to use `.clone()` because `GodotString` is refcounted;
-                    // we can't just do a memcpy.
-                    let element = unsafe { (*ptr.offset(offset)).clone() };
-                    vec.push(element);
+                // SAFETY: `ptr` points to the first of `len` contiguous, initialized elements, which
+                // stay valid as long as `self` is borrowed (no modification possible meanwhile).
+                unsafe { std::slice::from_raw_parts(ptr, len) }
+            }
+
+            /// Returns an exclusive view of the array's contents, without copying elements one by one.
+            ///
+            /// If the underlying buffer is shared with other copies of this array, Godot's
+            /// copy-on-write duplicates it once here; afterwards, writes through the slice only
+            /// affect this array.
+            pub fn as_mut_slice(&mut self) -> &mut [$Element] {
+                let len = self.len();
+                if len == 0 {
+                    return &mut [];
                 }
-                vec
+
+                // The non-const index operator triggers copy-on-write, if necessary.
+                let ptr = self.ptr_mut(0);
+                // SAFETY: `ptr` points to the first of `len` contiguous, initialized elements, which
+                // are exclusively owned by `self` after copy-on-write.
+                unsafe { std::slice::from_raw_parts_mut(ptr, len) }
             }
 
             /// Clears the array, removing all elements.
@@ -240,6 +264,22 @@ macro_rules! impl_packed_array {
                 self.as_inner().fill(Self::into_arg(value));
             }
 
+            /// Appends all elements of a slice at the end of this array.
+            ///
+            /// Resizes only once; for `Copy` element types, the elements are copied with a single
+            /// memcpy. Strings are cloned, which increments their reference counts.
+            pub fn extend_from_slice(&mut self, other: &[$Element]) {
+                if other.is_empty() {
+                    return;
+                }
+
+                let old_len = self.len();
+                self.resize(old_len + other.len());
+
+                // `clone_from_slice` is a memcpy for `Copy` types.
+                self.as_mut_slice()[old_len..].clone_from_slice(other);
+            }
+
             /// Appends another array at the end of this array. Equivalent of `append_array` in
             /// GDScript.
             pub fn extend_array(&mut self, other: &$PackedArray) {
@@ -333,23 +373,12 @@ macro_rules! impl_packed_array {
         }
 
         /// Creates a `$PackedArray` from the given slice.
+        ///
+        /// Allocates once; for `Copy` element types, the contents are copied with a single memcpy.
         impl From<&[$Element]> for $PackedArray {
             fn from(slice: &[$Element]) -> Self {
                 let mut array = Self::new();
-                let len = slice.len();
-                if len == 0 {
-                    return array;
-                }
-                array.resize(len);
-                let ptr = array.ptr_mut(0);
-                for (i, element) in slice.iter().enumerate() {
-                    // SAFETY: The array contains exactly `len` elements, stored contiguously in memory.
-                    unsafe {
-                        // `GodotString` does not implement `Copy` so we have to call `.clone()`
-                        // here.
-                        *ptr.offset(to_isize(i)) = element.clone();
-                    }
-                }
+                array.extend_from_slice(slice);
                 array
             }
         }
@@ -366,12 +395,30 @@ macro_rules! impl_packed_array {
         /// Extends a `$PackedArray` with the contents of an iterator.
         impl Extend<$Element> for $PackedArray {
             fn extend<I: IntoIterator<Item = $Element>>(&mut self, iter: I) {
-                // Unfortunately the GDExtension API does not offer the equivalent of `Vec::reserve`.
-                // Otherwise we could use it to pre-allocate based on `iter.size_hint()`.
-                //
-                // A faster implementation using `resize()` and direct pointer writes might still be
-                // possible.
-                for item in iter.into_iter() {
+                // The GDExtension API does not offer the equivalent of `Vec::reserve`. Instead, we
+                // resize once to the lower bound of `size_hint()` and write those elements directly.
+                // Remaining elements (if the hint was too low) are pushed one by one.
+                let mut iter = iter.into_iter();
+                let (lower_bound, _) = iter.size_hint();
+
+                if lower_bound > 0 {
+                    let old_len = self.len();
+                    self.resize(old_len + lower_bound);
+
+                    let mut written = 0;
+                    // `zip` polls the slice first, so no element is taken from `iter` without a slot.
+                    for (slot, item) in self.as_mut_slice()[old_len..].iter_mut().zip(iter.by_ref()) {
+                        *slot = item;
+                        written += 1;
+                    }
+
+                    // Iterator yielded less than its lower bound (incorrect, but not UB per `Iterator` docs).
+                    if written < lower_bound {
+                        self.resize(old_len + written);
+                    }
+                }
+
+                for item in iter {
                     self.push(item);
                 }
             }
@@ -399,6 +446,52 @@ macro_rules! impl_packed_array {
     }
 }
 
+/// Adds parallel iteration through [rayon](https://docs.rs/rayon) to a packed array type.
+///
+/// All methods operate on the slice views, so the array is accessed (and, for mutable access, copied-on-write) once up
+/// front; rayon then splits the contiguous buffer across its thread pool without further FFI calls.
+#[cfg(feature = "rayon")]
+macro_rules! impl_packed_array_par {
+    ($PackedArray:ident, $Element:ty) => {
+        impl $PackedArray {
+            /// Returns a parallel iterator over the elements. Requires the `rayon` feature.
+            pub fn par_iter(&self) -> rayon::slice::Iter<'_, $Element> {
+                use rayon::prelude::*;
+                self.as_slice().par_iter()
+            }
+
+            /// Returns a parallel iterator that allows modifying each element. Requires the `rayon` feature.
+            pub fn par_iter_mut(&mut self) -> rayon::slice::IterMut<'_, $Element> {
+                use rayon::prelude::*;
+                self.as_mut_slice().par_iter_mut()
+            }
+
+            /// Returns a parallel iterator over non-overlapping chunks of `chunk_size` elements; the last chunk may be
+            /// shorter. Requires the `rayon` feature.
+            ///
+            /// # Panics
+            /// If `chunk_size` is 0.
+            pub fn par_chunks(&self, chunk_size: usize) -> rayon::slice::Chunks<'_, $Element> {
+                use rayon::prelude::*;
+                self.as_slice().par_chunks(chunk_size)
+            }
+
+            /// Returns a parallel iterator over non-overlapping, mutable chunks of `chunk_size` elements; the last
+            /// chunk may be shorter. Requires the `rayon` feature.
+            ///
+            /// # Panics
+            /// If `chunk_size` is 0.
+            pub fn par_chunks_mut(
+                &mut self,
+                chunk_size: usize,
+            ) -> rayon::slice::ChunksMut<'_, $Element> {
+                use rayon::prelude::*;
+                self.as_mut_slice().par_chunks_mut(chunk_size)
+            }
+        }
+    };
+}
+
 impl_packed_array!(
     type_name: PackedByteArray,
     element_type: u8,
@@ -559,4 +652,19 @@ impl_packed_array!(
         Drop => packed_color_array_destroy;
         PartialEq => packed_color_array_operator_equal;
     },
-);
\ No newline at end of file
+);
+
+// Not for PackedStringArray: its element GodotString is neither Send nor Sync, so it cannot be shared across threads.
+#[cfg(feature = "rayon")]
+mod par {
+    use super::*;
+
+    impl_packed_array_par!(PackedByteArray, u8);
+    impl_packed_array_par!(PackedInt32Array, i32);
+    impl_packed_array_par!(PackedInt64Array, i64);
+    impl_packed_array_par!(PackedFloat32Array, f32);
+    impl_packed_array_par!(PackedFloat64Array, f64);
+    impl_packed_array_par!(PackedVector2Array, Vector2);
+    impl_packed_array_par!(PackedVector3Array, Vector3);
+    impl_packed_array_par!(PackedColorArray, Color);
+}
@@ -167,6 +167,25 @@ impl Quaternion {
         scale0 * self + scale1 * to1
     }
 
+    /// Spherically interpolates each element of `values` towards the element at the same index in `to`, in place.
+    ///
+    /// Same result as `*value = value.slerp(to, weight)` for each pair.
+    ///
+    /// # Panics
+    /// If `values` and `to` have different lengths.
+    pub fn slerp_batch(values: &mut [Self], to: &[Self], weight: real) {
+        assert_eq!(
+            values.len(),
+            to.len(),
+            "batch operation on slices of different lengths"
+        );
+
+        // The trigonometric functions dominate, and are not vectorized; so there is no gain from a SoA layout here.
+        for (value, to) in values.iter_mut().zip(to) {
+            *value = value.slerp(*to, weight);
+        }
+    }
+
     pub fn slerpni(self, to: Self, weight: real) -> Self {
         let dot = self.dot(to);
         if dot.abs() > 0.9999 {
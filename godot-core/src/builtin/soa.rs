@@ -0,0 +1,237 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Structure-of-arrays kernels for batch operations on slices of vectors.
+//!
+//! Slices of `Vector3` are processed in chunks of [`LANES`] elements. Each chunk is transposed into one [`RVec4`]
+//! per component, so that a single vector operation acts on all elements of the chunk. With single precision,
+//! `RVec4` is backed by SIMD registers. Elements that do not fill a whole chunk are processed one by one.
+
+use super::{real, RVec4, Vector3};
+
+/// Number of elements per chunk.
+pub(crate) const LANES: usize = 4;
+
+/// [`LANES`] values of type `Vector3`, stored per component.
+#[derive(Copy, Clone)]
+pub(crate) struct Vector3x4 {
+    pub x: RVec4,
+    pub y: RVec4,
+    pub z: RVec4,
+}
+
+impl Vector3x4 {
+    #[inline]
+    pub fn load(chunk: &[Vector3]) -> Self {
+        let [a, b, c, d]: [Vector3; LANES] = chunk.try_into().expect("chunk of LANES elements");
+
+        Self {
+            x: RVec4::new(a.x, b.x, c.x, d.x),
+            y: RVec4::new(a.y, b.y, c.y, d.y),
+            z: RVec4::new(a.z, b.z, c.z, d.z),
+        }
+    }
+
+    #[inline]
+    pub fn store(self, chunk: &mut [Vector3]) {
+        let (x, y, z) = (self.x.to_array(), self.y.to_array(), self.z.to_array());
+        for (i, v) in chunk.iter_mut().enumerate() {
+            *v = Vector3::new(x[i], y[i], z[i]);
+        }
+    }
+
+    /// Dot product of each element with the same vector `v`.
+    #[inline]
+    pub fn dot_splat(self, v: Vector3) -> RVec4 {
+        self.x * v.x + self.y * v.y + self.z * v.z
+    }
+
+    #[inline]
+    pub fn length_squared(self) -> RVec4 {
+        self.x * self.x + self.y * self.y + self.z * self.z
+    }
+
+    #[inline]
+    pub fn lerp(self, to: Self, weight: real) -> Self {
+        Self {
+            x: self.x + (to.x - self.x) * weight,
+            y: self.y + (to.y - self.y) * weight,
+            z: self.z + (to.z - self.z) * weight,
+        }
+    }
+}
+
+/// Replaces each element of `values` with `simd` (for full chunks) or `scalar` (for the remainder) applied to it.
+#[inline]
+pub(crate) fn map_in_place(
+    values: &mut [Vector3],
+    simd: impl Fn(Vector3x4) -> Vector3x4,
+    scalar: impl Fn(Vector3) -> Vector3,
+) {
+    let mut chunks = values.chunks_exact_mut(LANES);
+    for chunk in &mut chunks {
+        simd(Vector3x4::load(chunk)).store(chunk);
+    }
+
+    for v in chunks.into_remainder() {
+        *v = scalar(*v);
+    }
+}
+
+/// Like [`map_in_place`], but combines each element with the element at the same index in `others`.
+///
+/// # Panics
+/// If `values` and `others` have different lengths.
+#[inline]
+pub(crate) fn zip_in_place(
+    values: &mut [Vector3],
+    others: &[Vector3],
+    simd: impl Fn(Vector3x4, Vector3x4) -> Vector3x4,
+    scalar: impl Fn(Vector3, Vector3) -> Vector3,
+) {
+    assert_eq!(
+        values.len(),
+        others.len(),
+        "batch operation on slices of different lengths"
+    );
+
+    let mut chunks = values.chunks_exact_mut(LANES);
+    let mut other_chunks = others.chunks_exact(LANES);
+    for (chunk, other) in (&mut chunks).zip(&mut other_chunks) {
+        simd(Vector3x4::load(chunk), Vector3x4::load(other)).store(chunk);
+    }
+
+    for (v, other) in chunks
+        .into_remainder()
+        .iter_mut()
+        .zip(other_chunks.remainder())
+    {
+        *v = scalar(*v, *other);
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use crate::builtin::{Basis, Quaternion, Transform3D};
+
+    use super::*;
+
+    /// Deterministic sample vectors, including zero and a non-finite vector; lengths cover full chunks and remainders.
+    fn samples(len: usize) -> Vec<Vector3> {
+        (0..len)
+            .map(|i| match i % 7 {
+                0 => Vector3::ZERO,
+                5 => Vector3::new(real::INFINITY, 1.0, 0.0),
+                _ => {
+                    let i = i as real;
+                    Vector3::new(i * 0.5 - 3.0, 1.5 - i * 0.25, i * i * 0.125)
+                }
+            })
+            .collect()
+    }
+
+    fn assert_batch_eq(batched: &[Vector3], expected: &[Vector3]) {
+        assert_eq!(batched.len(), expected.len());
+        for (i, (a, b)) in batched.iter().zip(expected).enumerate() {
+            // Non-finite inputs must propagate the same way, NaN included.
+            let same = |a: real, b: real| a == b || (a.is_nan() && b.is_nan());
+            let equal =
+                a.is_equal_approx(*b) || (same(a.x, b.x) && same(a.y, b.y) && same(a.z, b.z));
+            assert!(
+                equal,
+                "mismatch at index {i}: batched {a:?}, expected {b:?}"
+            );
+        }
+    }
+
+    #[test]
+    fn xform_slice_matches_scalar() {
+        let transform = Transform3D::new(
+            Basis::from_cols(
+                Vector3::new(1.0, 2.0, 3.0),
+                Vector3::new(-4.0, 5.0, 0.5),
+                Vector3::new(7.0, 0.0, -9.0),
+            ),
+            Vector3::new(10.0, -11.0, 12.0),
+        );
+
+        for len in 0..=9 {
+            let mut points = samples(len);
+            let expected: Vec<_> = points.iter().map(|&v| transform * v).collect();
+
+            transform.xform_slice(&mut points);
+            assert_batch_eq(&points, &expected);
+        }
+    }
+
+    #[test]
+    fn mul_slice_matches_scalar() {
+        let basis = Basis::from_axis_angle(Vector3::new(1.0, 2.0, 3.0).normalized(), 0.7)
+            .scaled(Vector3::new(2.0, 1.0, 0.5));
+
+        for len in 0..=9 {
+            let mut vectors = samples(len);
+            let expected: Vec<_> = vectors.iter().map(|&v| basis * v).collect();
+
+            basis.mul_slice(&mut vectors);
+            assert_batch_eq(&vectors, &expected);
+        }
+    }
+
+    #[test]
+    fn normalize_slice_matches_scalar() {
+        for len in 0..=9 {
+            let mut vectors = samples(len);
+            let expected: Vec<_> = vectors.iter().map(|v| v.normalized()).collect();
+
+            Vector3::normalize_slice(&mut vectors);
+            assert_batch_eq(&vectors, &expected);
+        }
+    }
+
+    #[test]
+    fn lerp_slice_matches_scalar() {
+        for len in 0..=9 {
+            let mut values = samples(len);
+            let to: Vec<_> = values.iter().map(|&v| -v + Vector3::ONE).collect();
+            let expected: Vec<_> = values
+                .iter()
+                .zip(&to)
+                .map(|(v, &t)| v.lerp(t, 0.3))
+                .collect();
+
+            Vector3::lerp_slice(&mut values, &to, 0.3);
+            assert_batch_eq(&values, &expected);
+        }
+    }
+
+    #[test]
+    #[should_panic]
+    fn lerp_slice_different_lengths() {
+        Vector3::lerp_slice(&mut samples(4), &samples(5), 0.5);
+    }
+
+    #[test]
+    fn slerp_batch_matches_scalar() {
+        let from = [
+            Quaternion::new(0.0, 0.0, 0.0, 1.0),
+            Quaternion::from_angle_axis(Vector3::UP, 1.0),
+            Quaternion::from_angle_axis(Vector3::RIGHT, -2.5),
+        ];
+        let to = [
+            Quaternion::from_angle_axis(Vector3::BACK, 0.5),
+            Quaternion::from_angle_axis(Vector3::UP, 1.0),
+            Quaternion::from_angle_axis(Vector3::new(1.0, 1.0, 0.0).normalized(), 3.0),
+        ];
+
+        let mut values = from;
+        Quaternion::slerp_batch(&mut values, &to, 0.25);
+
+        for i in 0..from.len() {
+            assert_eq!(values[i], from[i].slerp(to[i], 0.25));
+        }
+    }
+}
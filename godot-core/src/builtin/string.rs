@@ -5,6 +5,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+use std::cell::RefCell;
 use std::{convert::Infallible, fmt, str::FromStr};
 
 use godot_ffi as sys;
@@ -44,14 +45,8 @@ impl GodotString {
     /// Note: This operation is *O*(*n*). Consider using [`chars_unchecked`]
     /// if you can make sure the string is a valid UTF-32.
     pub fn chars_checked(&self) -> &[char] {
-        unsafe {
-            let s = self.string_sys();
-            let len = interface_fn!(string_to_utf32_chars)(s, std::ptr::null_mut(), 0);
-            let ptr = interface_fn!(string_operator_index_const)(s, 0);
-
-            validate_unicode_scalar_sequence(std::slice::from_raw_parts(ptr, len as usize))
-                .expect("GodotString::chars_checked: string contains invalid unicode scalar values")
-        }
+        validate_unicode_scalar_sequence(self.code_points())
+            .expect("GodotString::chars_checked: string contains invalid unicode scalar values")
     }
 
     /// Gets the internal chars slice from a [`GodotString`].
@@ -62,13 +57,79 @@ impl GodotString {
     /// Godot allows for unpaired surrogates and out of range code points to be appended
     /// into the string.
     pub unsafe fn chars_unchecked(&self) -> &[char] {
-        let s = self.string_sys();
-        let len = interface_fn!(string_to_utf32_chars)(s, std::ptr::null_mut(), 0);
-        let ptr = interface_fn!(string_operator_index_const)(s, 0);
-        std::slice::from_raw_parts(ptr as *const char, len as usize)
+        let code_points = self.code_points();
+        std::slice::from_raw_parts(code_points.as_ptr() as *const char, code_points.len())
+    }
+
+    /// Converts the string to UTF-8 and passes it to `f`, without allocating a new `String`.
+    ///
+    /// The conversion is written into a buffer that is reused across calls on the same thread. Use this
+    /// instead of `String::from()` when the UTF-8 text is only needed temporarily, e.g. for logging or
+    /// comparisons. Nested calls (from within `f`) fall back to a temporary buffer.
+    pub fn with_utf8<R>(&self, f: impl FnOnce(&str) -> R) -> R {
+        UTF8_BUFFER.with(|buffer| match buffer.try_borrow_mut() {
+            Ok(mut buffer) => {
+                self.write_utf8_bytes(&mut buffer);
+                let result = f(utf8_str(&buffer));
+
+                // Don't hold on to memory of exceptionally long strings.
+                buffer.shrink_to(UTF8_BUFFER_RETAINED_CAPACITY);
+                result
+            }
+            Err(_) => {
+                let mut buffer = Vec::new();
+                self.write_utf8_bytes(&mut buffer);
+                f(utf8_str(&buffer))
+            }
+        })
+    }
+
+    /// Code points of the string, as stored by Godot (UTF-32, not validated).
+    fn code_points(&self) -> &[u32] {
+        unsafe {
+            let s = self.string_sys();
+            let len = interface_fn!(string_to_utf32_chars)(s, std::ptr::null_mut(), 0);
+            if len <= 0 {
+                // Empty strings have no buffer; don't index into it.
+                return &[];
+            }
+
+            let ptr = interface_fn!(string_operator_index_const)(s, 0);
+            std::slice::from_raw_parts(ptr, len as usize)
+        }
+    }
+
+    /// Replaces the contents of `buf` with the UTF-8 encoding of this string.
+    fn write_utf8_bytes(&self, buf: &mut Vec<u8>) {
+        buf.clear();
+
+        unsafe {
+            let s = self.string_sys();
+            let len = interface_fn!(string_to_utf8_chars)(s, std::ptr::null_mut(), 0);
+            assert!(len >= 0);
+
+            buf.reserve(len as usize);
+            let written = interface_fn!(string_to_utf8_chars)(s, buf.as_mut_ptr() as *mut i8, len);
+
+            // SAFETY: Godot wrote `written` bytes (at most `len`, the `p_max_write_length`) into the reserved capacity.
+            buf.set_len(written.clamp(0, len) as usize);
+        }
     }
 }
 
+thread_local! {
+    /// Conversion buffer for [`GodotString::with_utf8()`] and `Display`.
+    static UTF8_BUFFER: RefCell<Vec<u8>> = RefCell::new(Vec::new());
+}
+
+/// Capacity the thread-local UTF-8 buffer keeps between conversions.
+const UTF8_BUFFER_RETAINED_CAPACITY: usize = 16 * 1024;
+
+fn utf8_str(bytes: &[u8]) -> &str {
+    // Note: could use from_utf8_unchecked() but for now prefer safety
+    std::str::from_utf8(bytes).expect("GodotString: conversion to UTF-8 failed")
+}
+
 impl GodotFfi for GodotString {
     ffi_methods! { type sys::GDExtensionTypePtr = *mut Opaque; .. }
 
@@ -107,22 +168,12 @@ where
 
 impl From<&GodotString> for String {
     fn from(string: &GodotString) -> Self {
-        unsafe {
-            let len =
-                interface_fn!(string_to_utf8_chars)(string.string_sys(), std::ptr::null_mut(), 0);
+        // Exactly one allocation, of the right size; the buffer is moved into the result.
+        let mut buf = Vec::new();
+        string.write_utf8_bytes(&mut buf);
 
-            assert!(len >= 0);
-            let mut buf = vec![0u8; len as usize];
-
-            interface_fn!(string_to_utf8_chars)(
-                string.string_sys(),
-                buf.as_mut_ptr() as *mut i8,
-                len,
-            );
-
-            // Note: could use from_utf8_unchecked() but for now prefer safety
-            String::from_utf8(buf).expect("String::from_utf8")
-        }
+        // Note: could use from_utf8_unchecked() but for now prefer safety
+        String::from_utf8(buf).expect("String::from_utf8")
     }
 }
 
@@ -138,16 +189,14 @@ impl FromStr for GodotString {
 
 impl fmt::Display for GodotString {
     fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
-        let s = String::from(self);
-        f.write_str(s.as_str())
+        self.with_utf8(|s| f.write_str(s))
     }
 }
 
 /// Uses literal syntax from GDScript: `"string"`
 impl fmt::Debug for GodotString {
     fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
-        let s = String::from(self);
-        write!(f, "\"{s}\"")
+        self.with_utf8(|s| write!(f, "\"{s}\""))
     }
 }
 
@@ -5,86 +5,154 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-#[cfg(target_arch = "aarch64")]
-use std::arch::aarch64::*;
-#[cfg(target_arch = "x86")]
-use std::arch::x86::*;
-#[cfg(target_arch = "x86_64")]
-use std::arch::x86_64::*;
-
 /// Validates is a [`u32`] slice contains only valid [unicode scalar values](https://www.unicode.org/glossary/#unicode_scalar_value)
 pub fn validate_unicode_scalar_sequence(seq: &[u32]) -> Option<&[char]> {
-    unsafe {
-        let mut ptr = seq.as_ptr();
-        let ptr_end = seq.as_ptr().add(seq.len());
-
-        #[cfg(any(target_arch = "x86_64", target_arch = "x86"))]
-        loop {
-            let ptr_next = ptr.add(4);
-            if ptr_next > ptr_end {
-                break;
-            }
+    #[cfg(any(target_arch = "x86_64", target_arch = "x86"))]
+    let valid = x86::validate(seq);
 
-            let block = _mm_loadu_si128(ptr as *const __m128i);
+    #[cfg(target_arch = "aarch64")]
+    let valid = aarch64::validate(seq);
 
-            // check if has any character greater than `char::MAX` or less than 0, (SSE2 uses signed math)
-            if _mm_movemask_epi8(_mm_and_si128(
-                _mm_cmpgt_epi32(block, _mm_set1_epi32(-1)),
-                _mm_cmplt_epi32(block, _mm_set1_epi32(char::MAX as i32 + 1)),
-            )) != 0xFFFF
-            {
-                return None;
-            }
+    #[cfg(not(any(target_arch = "x86_64", target_arch = "x86", target_arch = "aarch64")))]
+    let valid = validate_scalar(seq);
 
-            // check if has any high-surrogate and low-surrogate code points
-            if _mm_testz_si128(
-                _mm_cmpgt_epi32(block, _mm_set1_epi32(0xD7FF)),
-                _mm_cmplt_epi32(block, _mm_set1_epi32(0xE000)),
-            ) == 0
-            {
-                return None;
-            }
+    // SAFETY: all values are unicode scalar values, and `char` has the same layout as `u32`.
+    valid.then(|| unsafe { std::slice::from_raw_parts(seq.as_ptr() as *const char, seq.len()) })
+}
 
-            ptr = ptr_next;
+// A code point `c` is a unicode scalar value iff `(c ^ 0xD800).wrapping_sub(0x800) < 0x110000 - 0x800`:
+// the XOR maps the surrogates `0xD800..0xE000` onto `0..0x800` (which the subtraction then wraps around), and
+// permutes all other values below `0x110000` among themselves. This needs only one comparison per lane.
+const SURROGATE_XOR: u32 = 0xD800;
+const SURROGATE_LEN: u32 = 0xE000 - 0xD800;
+const VALID_LIMIT: u32 = char::MAX as u32 + 1 - SURROGATE_LEN;
+
+/// Reference implementation, also used for the tails of SIMD kernels.
+fn validate_scalar(seq: &[u32]) -> bool {
+    seq.iter().all(|&c| char::from_u32(c).is_some())
+}
+
+#[cfg(any(target_arch = "x86_64", target_arch = "x86"))]
+mod x86 {
+    #[cfg(target_arch = "x86")]
+    use std::arch::x86::*;
+    #[cfg(target_arch = "x86_64")]
+    use std::arch::x86_64::*;
+
+    use super::{validate_scalar, SURROGATE_LEN, SURROGATE_XOR, VALID_LIMIT};
+
+    // SSE2/AVX2 only compare signed integers; flipping the sign bit of both sides turns that into an unsigned comparison.
+    const SIGN_BIT: u32 = 0x8000_0000;
+
+    pub fn validate(seq: &[u32]) -> bool {
+        // Feature detection is cached by std, so this is a cheap check per call.
+        if is_x86_feature_detected!("avx2") {
+            // SAFETY: AVX2 is available on this CPU.
+            unsafe { validate_avx2(seq) }
+        } else if is_x86_feature_detected!("sse2") {
+            // SAFETY: SSE2 is available on this CPU.
+            unsafe { validate_sse2(seq) }
+        } else {
+            validate_scalar(seq)
         }
+    }
 
-        #[cfg(target_arch = "aarch64")]
-        loop {
-            let ptr_next = ptr.add(4);
-            if ptr_next > ptr_end {
-                break;
+    /// Checks 16 code points per iteration, in two 256-bit vectors.
+    #[target_feature(enable = "avx2")]
+    unsafe fn validate_avx2(seq: &[u32]) -> bool {
+        let mut chunks = seq.chunks_exact(16);
+        for chunk in &mut chunks {
+            let ptr = chunk.as_ptr() as *const __m256i;
+            let valid = _mm256_and_si256(
+                is_valid_avx2(_mm256_loadu_si256(ptr)),
+                is_valid_avx2(_mm256_loadu_si256(ptr.add(1))),
+            );
+
+            if _mm256_movemask_epi8(valid) != -1 {
+                return false;
             }
+        }
 
-            let block = vld1q_u32(ptr as *const u32);
+        validate_scalar(chunks.remainder())
+    }
 
-            // check if has any character bigger than `char::MAX`
-            if vmaxvq_u32(block) >= char::MAX as u32 {
-                return None;
-            }
+    /// Lane-wise all-ones for unicode scalar values, zero otherwise.
+    #[inline]
+    #[target_feature(enable = "avx2")]
+    unsafe fn is_valid_avx2(block: __m256i) -> __m256i {
+        let folded = _mm256_sub_epi32(
+            _mm256_xor_si256(block, _mm256_set1_epi32(SURROGATE_XOR as i32)),
+            _mm256_set1_epi32(SURROGATE_LEN as i32),
+        );
+        let folded = _mm256_xor_si256(folded, _mm256_set1_epi32(SIGN_BIT as i32));
+        _mm256_cmpgt_epi32(_mm256_set1_epi32((VALID_LIMIT ^ SIGN_BIT) as i32), folded)
+    }
 
-            // check if has any high-surrogate and low-surrogate code points
-            // This is in the range `0xD800..0xE000`.
-            if vminvq_u32(vsubq_u32(block, vdupq_n_u32(0xD800))) < (0xE000 - 0xD800) {
-                return None;
+    /// Checks 8 code points per iteration, in two 128-bit vectors.
+    #[target_feature(enable = "sse2")]
+    pub(super) unsafe fn validate_sse2(seq: &[u32]) -> bool {
+        let mut chunks = seq.chunks_exact(8);
+        for chunk in &mut chunks {
+            let ptr = chunk.as_ptr() as *const __m128i;
+            let valid = _mm_and_si128(
+                is_valid_sse2(_mm_loadu_si128(ptr)),
+                is_valid_sse2(_mm_loadu_si128(ptr.add(1))),
+            );
+
+            if _mm_movemask_epi8(valid) != 0xFFFF {
+                return false;
             }
-
-            ptr = ptr_next;
         }
 
-        loop {
-            if ptr >= ptr_end {
-                break;
-            }
+        validate_scalar(chunks.remainder())
+    }
 
-            char::from_u32(*ptr)?;
+    /// Lane-wise all-ones for unicode scalar values, zero otherwise.
+    #[inline]
+    #[target_feature(enable = "sse2")]
+    unsafe fn is_valid_sse2(block: __m128i) -> __m128i {
+        let folded = _mm_sub_epi32(
+            _mm_xor_si128(block, _mm_set1_epi32(SURROGATE_XOR as i32)),
+            _mm_set1_epi32(SURROGATE_LEN as i32),
+        );
+        let folded = _mm_xor_si128(folded, _mm_set1_epi32(SIGN_BIT as i32));
+        _mm_cmpgt_epi32(_mm_set1_epi32((VALID_LIMIT ^ SIGN_BIT) as i32), folded)
+    }
+}
 
-            ptr = ptr.add(1);
+#[cfg(target_arch = "aarch64")]
+mod aarch64 {
+    use std::arch::aarch64::*;
+
+    use super::{validate_scalar, SURROGATE_LEN, SURROGATE_XOR, VALID_LIMIT};
+
+    /// Checks 8 code points per iteration, in two 128-bit vectors. NEON is always available on aarch64.
+    pub fn validate(seq: &[u32]) -> bool {
+        let mut chunks = seq.chunks_exact(8);
+        for chunk in &mut chunks {
+            // SAFETY: `chunk` holds 8 readable `u32` values.
+            let all_valid = unsafe {
+                let ptr = chunk.as_ptr();
+                let valid = vandq_u32(is_valid(vld1q_u32(ptr)), is_valid(vld1q_u32(ptr.add(4))));
+                vminvq_u32(valid) == u32::MAX
+            };
+
+            if !all_valid {
+                return false;
+            }
         }
 
-        Some(std::slice::from_raw_parts(
-            seq.as_ptr() as *const char,
-            seq.len(),
-        ))
+        validate_scalar(chunks.remainder())
+    }
+
+    /// Lane-wise all-ones for unicode scalar values, zero otherwise.
+    #[inline]
+    unsafe fn is_valid(block: uint32x4_t) -> uint32x4_t {
+        let folded = vsubq_u32(
+            veorq_u32(block, vdupq_n_u32(SURROGATE_XOR)),
+            vdupq_n_u32(SURROGATE_LEN),
+        );
+        vcltq_u32(folded, vdupq_n_u32(VALID_LIMIT))
     }
 }
 
@@ -171,4 +239,95 @@ mod tests {
             assert!(super::validate_unicode_scalar_sequence(chars.as_slice()).is_none());
         }
     }
+
+    #[test]
+    fn check_boundary_values() {
+        let valid = [0, 0xD7FF, 0xE000, 0xFFFF, 0x10000, char::MAX as u32];
+        let invalid = [
+            0xD800,
+            0xDBFF,
+            0xDC00,
+            0xDFFF,
+            0x110000,
+            0x7FFF_FFFF,
+            0x8000_0000,
+            u32::MAX,
+        ];
+
+        // Lengths and positions cover full SIMD blocks as well as scalar tails.
+        for len in 1..=40 {
+            for &fill in &valid {
+                let seq = vec![fill; len];
+                assert!(super::validate_unicode_scalar_sequence(&seq).is_some());
+
+                for pos in 0..len {
+                    for &bad in &invalid {
+                        let mut seq = seq.clone();
+                        seq[pos] = bad;
+                        assert!(
+                            super::validate_unicode_scalar_sequence(&seq).is_none(),
+                            "{bad:#x} at {pos}/{len} not detected"
+                        );
+                    }
+                }
+            }
+        }
+
+        assert!(super::validate_unicode_scalar_sequence(&[]).is_some());
+    }
+
+    #[test]
+    fn check_matches_scalar() {
+        let mut rand = Rand::new(0x5EED);
+        for _ in 0..256 {
+            let len = rand.next() as usize % 100;
+            let seq: Vec<u32> = (0..len)
+                .map(|_| match rand.next() % 4 {
+                    0 => rand.next(),
+                    1 => rand.next() % (0xE000 - 0xD800) + 0xD800,
+                    _ => rand.next() % 0x80,
+                })
+                .collect();
+
+            let expected = super::validate_scalar(&seq);
+            assert_eq!(
+                super::validate_unicode_scalar_sequence(&seq).is_some(),
+                expected
+            );
+
+            // Dispatch prefers AVX2 where available; cover the SSE2 kernel explicitly.
+            #[cfg(any(target_arch = "x86_64", target_arch = "x86"))]
+            if is_x86_feature_detected!("sse2") {
+                assert_eq!(unsafe { super::x86::validate_sse2(&seq) }, expected);
+            }
+        }
+    }
+
+    /// Compares the SIMD kernel against the scalar loop. Run with:
+    /// `cargo test -p godot-core --release -- --ignored --nocapture bench_validate`
+    #[test]
+    #[ignore]
+    fn bench_validate_unicode() {
+        let mut rand = Rand::new(0xA102FE1);
+        let chars: Vec<u32> = (0..1_000_000)
+            .map(|_| rand.next() % (char::MAX as u32))
+            .filter_map(char::from_u32)
+            .map(|x| x as u32)
+            .collect();
+
+        let measure = |name: &str, f: &dyn Fn(&[u32]) -> bool| {
+            const ROUNDS: u32 = 100;
+            let start = std::time::Instant::now();
+            for _ in 0..ROUNDS {
+                assert!(f(&chars));
+            }
+            let per_round = start.elapsed() / ROUNDS;
+            println!("{name:>8}: {per_round:?} per {} code points", chars.len());
+        };
+
+        measure("scalar", &super::validate_scalar);
+        measure("dispatch", &|seq| {
+            super::validate_unicode_scalar_sequence(seq).is_some()
+        });
+    }
 }
\ No newline at end of file
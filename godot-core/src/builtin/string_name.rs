@@ -31,6 +31,23 @@ impl StringName {
         fn string_sys = sys;
         fn write_string_sys = write_sys;
     }
+
+    /// Returns true if both names refer to the same interned string, without calling into the engine.
+    ///
+    /// Godot interns every `StringName`, and its equality operator compares the internal data pointers. This
+    /// method does the same comparison on the opaque bytes, so it yields the same result as `==`.
+    #[doc(hidden)]
+    #[inline]
+    pub fn is_same_interned(&self, other: &Self) -> bool {
+        self.opaque == other.opaque
+    }
+
+    /// Address of the interned string data, which identifies the name like [`is_same_interned()`][Self::is_same_interned].
+    #[inline]
+    pub(crate) fn interned_id(&self) -> usize {
+        // SAFETY: a StringName consists of a single pointer to its interned data.
+        unsafe { std::ptr::read(self.string_sys() as *const usize) }
+    }
 }
 
 impl GodotFfi for StringName {
@@ -132,4 +149,53 @@ impl From<&StringName> for String {
         let intermediate = GodotString::from(s);
         Self::from(&intermediate)
     }
-}
\ No newline at end of file
+}
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Returns a `&'static` [`StringName`] for a string known at compile time, constructing it only once.
+///
+/// The first evaluation of each macro call site converts the string and caches the result in a `static`; subsequent
+/// evaluations return the cached instance without allocating or hashing. The argument must be a constant expression
+/// (literal, `const` or `stringify!`), since it is only evaluated once per call site.
+///
+/// Cached names live until the library is unloaded and are never dropped, like their interned counterpart in Godot.
+///
+/// Example:
+/// ```no_run
+/// # use godot::prelude::*;
+/// let name: &'static StringName = static_sname!("ready");
+/// ```
+#[macro_export]
+macro_rules! static_sname {
+    ($str:expr) => {{
+        static STRING_NAME: $crate::builtin::StaticStringName =
+            $crate::builtin::StaticStringName::new();
+
+        STRING_NAME.get_or_init(|| $crate::builtin::StringName::from($str))
+    }};
+}
+
+/// Storage behind [`static_sname!`]; not intended for direct use.
+#[doc(hidden)]
+pub struct StaticStringName {
+    cell: once_cell::sync::OnceCell<StringName>,
+}
+
+impl StaticStringName {
+    #[allow(clippy::new_without_default)] // must be const, only used in statics
+    pub const fn new() -> Self {
+        Self {
+            cell: once_cell::sync::OnceCell::new(),
+        }
+    }
+
+    #[inline]
+    pub fn get_or_init(&self, init: impl FnOnce() -> StringName) -> &StringName {
+        self.cell.get_or_init(init)
+    }
+}
+
+// SAFETY: the cached StringName is never mutated or dropped after initialization, which itself is synchronized by
+// OnceCell. Godot's interned StringName data is reference-counted thread-safely and can be read from any thread.
+unsafe impl Sync for StaticStringName {}
+unsafe impl Send for StaticStringName {}
@@ -9,6 +9,7 @@ use godot_ffi as sys;
 use sys::{ffi_methods, GodotFfi};
 
 use super::glam_helpers::{GlamConv, GlamType};
+use super::soa::{self, Vector3x4};
 use super::{real, RAffine3};
 use super::{Basis, Projection, Vector3};
 
@@ -122,6 +123,25 @@ impl Transform3D {
         }
     }
 
+    /// Transforms all `points` in place, with the same result as `*point = self * *point` for each element.
+    ///
+    /// Points are processed several at a time, which is faster than transforming them one by one. To transform
+    /// a `PackedVector3Array`, pass its [`as_mut_slice()`](super::PackedVector3Array::as_mut_slice).
+    pub fn xform_slice(&self, points: &mut [Vector3]) {
+        let [row_x, row_y, row_z] = self.basis.rows;
+        let origin = self.origin;
+
+        soa::map_in_place(
+            points,
+            |v| Vector3x4 {
+                x: v.dot_splat(row_x) + origin.x,
+                y: v.dot_splat(row_y) + origin.y,
+                z: v.dot_splat(row_z) + origin.z,
+            },
+            |v| *self * v,
+        );
+    }
+
     /// Returns `true if this transform and transform are approximately equal, by
     /// calling is_equal_approx each basis and origin.
     ///
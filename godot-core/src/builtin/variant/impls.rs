@@ -5,6 +5,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+use super::pod;
 use super::*;
 use crate::builtin::meta::VariantMetadata;
 use crate::builtin::*;
@@ -52,6 +53,11 @@ macro_rules! impl_variant_traits {
 
                 variant
             }
+
+            unsafe fn move_into_var_sys(self, dst: sys::GDExtensionVariantPtr) {
+                let converter = sys::builtin_fn!($from_fn);
+                converter(dst, self.sys());
+            }
         }
 
         impl FromVariant for $T {
@@ -81,12 +87,64 @@ macro_rules! impl_variant_traits {
     };
 }
 
+/// Like `impl_variant_traits!`, but for POD types that can take the layout-verified fast path (see `pod` module).
+macro_rules! impl_variant_traits_pod {
+    ($T:ty, $from_fn:ident, $to_fn:ident, $variant_type:ident $(, $param_metadata:ident)?) => {
+        impl ToVariant for $T {
+            fn to_variant(&self) -> Variant {
+                unsafe { Variant::from_var_sys_init(|variant_ptr| (*self).move_into_var_sys(variant_ptr)) }
+            }
+
+            unsafe fn move_into_var_sys(self, dst: sys::GDExtensionVariantPtr) {
+                if pod::is_enabled() {
+                    pod::write(dst, self);
+                } else {
+                    let converter = sys::builtin_fn!($from_fn);
+                    converter(dst, self.sys());
+                }
+            }
+        }
+
+        impl FromVariant for $T {
+            fn try_from_variant(variant: &Variant) -> Result<Self, VariantConversionError> {
+                if pod::is_enabled() {
+                    // The tag check replaces get_type(); the null-object special case is irrelevant for POD types.
+                    return unsafe { pod::read(variant) }.ok_or(VariantConversionError);
+                }
+
+                if variant.get_type() != Self::variant_type() {
+                    return Err(VariantConversionError)
+                }
+
+                let result = unsafe {
+                    Self::from_sys_init_default(|self_ptr| {
+                        let converter = sys::builtin_fn!($to_fn);
+                        converter(self_ptr, variant.var_sys());
+                    })
+                };
+
+                Ok(result)
+            }
+        }
+
+        impl_variant_metadata!($T, $variant_type; $(
+            fn param_metadata() -> sys::GDExtensionClassMethodArgumentMetadata {
+                sys::$param_metadata
+            }
+        )?);
+    };
+}
+
 macro_rules! impl_variant_traits_int {
     ($T:ty, $param_metadata:ident) => {
         impl ToVariant for $T {
             fn to_variant(&self) -> Variant {
                 i64::from(*self).to_variant()
             }
+
+            unsafe fn move_into_var_sys(self, dst: sys::GDExtensionVariantPtr) {
+                i64::from(self).move_into_var_sys(dst)
+            }
         }
 
         impl FromVariant for $T {
@@ -115,6 +173,10 @@ macro_rules! impl_variant_traits_float {
                 let double = *self as f64;
                 f64::to_variant(&double)
             }
+
+            unsafe fn move_into_var_sys(self, dst: sys::GDExtensionVariantPtr) {
+                (self as f64).move_into_var_sys(dst)
+            }
         }
 
         impl FromVariant for $T {
@@ -143,9 +205,9 @@ macro_rules! impl_variant_traits_float {
 mod impls {
     use super::*;
 
-    impl_variant_traits!(bool, bool_to_variant, bool_from_variant, Bool);
+    impl_variant_traits_pod!(bool, bool_to_variant, bool_from_variant, Bool);
     impl_variant_traits!(Basis, basis_to_variant, basis_from_variant, Basis);
-    impl_variant_traits!(Vector2, vector2_to_variant, vector2_from_variant, Vector2);
+    impl_variant_traits_pod!(Vector2, vector2_to_variant, vector2_from_variant, Vector2);
     impl_variant_traits!(Vector3, vector3_to_variant, vector3_from_variant, Vector3);
     impl_variant_traits!(Vector4, vector4_to_variant, vector4_from_variant, Vector4);
     impl_variant_traits!(Vector2i, vector2i_to_variant, vector2i_from_variant, Vector2i);
@@ -177,7 +239,7 @@ mod impls {
     impl_variant_traits!(Transform3D, transform_3d_to_variant, transform_3d_from_variant, Transform3D);
     impl_variant_traits!(Dictionary, dictionary_to_variant, dictionary_from_variant, Dictionary);
 
-    impl_variant_traits!(i64, int_to_variant, int_from_variant, Int, GDEXTENSION_METHOD_ARGUMENT_METADATA_INT_IS_INT64);
+    impl_variant_traits_pod!(i64, int_to_variant, int_from_variant, Int, GDEXTENSION_METHOD_ARGUMENT_METADATA_INT_IS_INT64);
     impl_variant_traits_int!(i8, GDEXTENSION_METHOD_ARGUMENT_METADATA_INT_IS_INT8);
     impl_variant_traits_int!(i16, GDEXTENSION_METHOD_ARGUMENT_METADATA_INT_IS_INT16);
     impl_variant_traits_int!(i32, GDEXTENSION_METHOD_ARGUMENT_METADATA_INT_IS_INT32);
@@ -187,7 +249,7 @@ mod impls {
     impl_variant_traits_int!(u32, GDEXTENSION_METHOD_ARGUMENT_METADATA_INT_IS_UINT32);
     // u64 is not supported, because it cannot be represented on GDScript side, and implicitly converting to i64 is error-prone.
 
-    impl_variant_traits!(f64, float_to_variant, float_from_variant, Float, GDEXTENSION_METHOD_ARGUMENT_METADATA_REAL_IS_DOUBLE);
+    impl_variant_traits_pod!(f64, float_to_variant, float_from_variant, Float, GDEXTENSION_METHOD_ARGUMENT_METADATA_REAL_IS_DOUBLE);
     impl_variant_traits_float!(f32, GDEXTENSION_METHOD_ARGUMENT_METADATA_REAL_IS_FLOAT);
 }
 
@@ -199,6 +261,10 @@ impl ToVariant for () {
     fn to_variant(&self) -> Variant {
         Variant::nil()
     }
+
+    unsafe fn move_into_var_sys(self, dst: sys::GDExtensionVariantPtr) {
+        sys::interface_fn!(variant_new_nil)(dst);
+    }
 }
 
 impl VariantMetadata for () {
@@ -211,6 +277,12 @@ impl ToVariant for Variant {
     fn to_variant(&self) -> Variant {
         self.clone()
     }
+
+    unsafe fn move_into_var_sys(self, dst: sys::GDExtensionVariantPtr) {
+        // Already a variant: bitwise move, no copy and no destructor call.
+        self.write_var_sys(dst);
+        std::mem::forget(self);
+    }
 }
 
 impl FromVariant for Variant {
@@ -12,6 +12,7 @@ use sys::types::OpaqueVariant;
 use sys::{ffi_methods, interface_fn};
 
 mod impls;
+mod pod;
 mod variant_traits;
 
 pub use impls::*;
@@ -153,6 +154,11 @@ impl Variant {
     }
 
     pub(crate) fn sys_type(&self) -> sys::GDExtensionVariantType {
+        if pod::is_enabled() {
+            // SAFETY: layout has been verified.
+            return unsafe { pod::read_tag(self) };
+        }
+
         unsafe {
             let ty: sys::GDExtensionVariantType = interface_fn!(variant_get_type)(self.var_sys());
             ty
@@ -201,6 +207,28 @@ impl Variant {
         sys::to_const_ptr(self.var_sys())
     }
 
+    /// Borrows a variant owned by Godot (e.g. a varcall argument), without copying it.
+    ///
+    /// # Safety
+    /// `variant_ptr` must point to a valid variant, which outlives `'a`.
+    #[doc(hidden)]
+    pub unsafe fn borrow_var_sys<'a>(variant_ptr: sys::GDExtensionConstVariantPtr) -> &'a Variant {
+        &*(variant_ptr as *const Variant)
+    }
+
+    /// Enables the `variant-fast-path` feature for this session, if the engine's variant layout passes the check.
+    pub(crate) fn initialize_fast_path() {
+        pod::initialize();
+    }
+
+    /// Checks whether direct access to `bool`, `int`, `float` and `Vector2` variants agrees with the FFI converters.
+    ///
+    /// This works independently of the `variant-fast-path` feature.
+    #[doc(hidden)]
+    pub fn __verify_fast_path() -> bool {
+        pod::verify_layout()
+    }
+
     pub(crate) fn ptr_from_sys(variant_ptr: sys::GDExtensionVariantPtr) -> *const Variant {
         assert!(!variant_ptr.is_null(), "ptr_from_sys: null variant pointer");
         variant_ptr as *const Variant
@@ -0,0 +1,212 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Direct tag/payload access for variants holding small POD types.
+//!
+//! Godot stores the variant type as a 32-bit enum at offset 0 and the value in a union at offset 8. For `bool`, `int`,
+//! `float` and `Vector2`, the value is plain data, so converting reduces to a few memory accesses instead of an FFI call.
+//! This layout is not part of the GDExtension API; the fast path is thus opt-in (feature `variant-fast-path`) and only
+//! activated once [`verify_layout()`] confirmed it against the converters of the running engine.
+
+use super::Variant;
+use crate::builtin::Vector2;
+use godot_ffi as sys;
+use std::mem::size_of;
+use std::ptr;
+use std::sync::atomic::{AtomicBool, Ordering};
+use sys::types::OpaqueVariant;
+use sys::{interface_fn, GodotFfi};
+
+const TAG_OFFSET: usize = 0;
+const PAYLOAD_OFFSET: usize = 8;
+
+const _: () = assert!(size_of::<sys::GDExtensionVariantType>() == 4);
+const _: () = assert!(size_of::<OpaqueVariant>() >= PAYLOAD_OFFSET + size_of::<Vector2>());
+
+static ENABLED: AtomicBool = AtomicBool::new(false);
+
+/// Whether the fast path is compiled in and has passed the layout check.
+#[inline(always)]
+pub(super) fn is_enabled() -> bool {
+    cfg!(feature = "variant-fast-path") && ENABLED.load(Ordering::Relaxed)
+}
+
+/// Runs the layout check and enables the fast path if it passes. Without the feature, this does nothing.
+pub(crate) fn initialize() {
+    if !cfg!(feature = "variant-fast-path") {
+        return;
+    }
+
+    let verified = verify_layout();
+    if !verified {
+        crate::godot_warn!(
+            "Variant layout differs from the expected one; variant-fast-path is disabled, falling back to FFI converters"
+        );
+    }
+
+    ENABLED.store(verified, Ordering::Relaxed);
+}
+
+/// Compares direct reads/writes against the FFI converters, in both directions, for sample values of each POD type.
+pub(super) fn verify_layout() -> bool {
+    let nil_ok = unsafe { read_tag(&Variant::nil()) } == sys::GDEXTENSION_VARIANT_TYPE_NIL;
+
+    nil_ok
+        && verify_samples(
+            &[false, true],
+            sys::builtin_fn!(bool_to_variant),
+            sys::builtin_fn!(bool_from_variant),
+        )
+        && verify_samples(
+            &[0, 1, -1, i64::MIN, i64::MAX, 0x0123_4567_89ab_cdef],
+            sys::builtin_fn!(int_to_variant),
+            sys::builtin_fn!(int_from_variant),
+        )
+        && verify_samples(
+            &[0.0, -0.0, 1.5, -2.25e300, f64::MIN_POSITIVE, f64::INFINITY],
+            sys::builtin_fn!(float_to_variant),
+            sys::builtin_fn!(float_from_variant),
+        )
+        && verify_samples(
+            &[Vector2::ZERO, Vector2::new(1.5, -2.0), Vector2::INF],
+            sys::builtin_fn!(vector2_to_variant),
+            sys::builtin_fn!(vector2_from_variant),
+        )
+}
+
+type ToVariantFn = unsafe extern "C" fn(sys::GDExtensionVariantPtr, sys::GDExtensionTypePtr);
+type FromVariantFn = unsafe extern "C" fn(sys::GDExtensionTypePtr, sys::GDExtensionVariantPtr);
+
+fn verify_samples<T>(samples: &[T], to_variant: ToVariantFn, from_variant: FromVariantFn) -> bool
+where
+    T: PodVariant + GodotFfi + PartialEq,
+{
+    samples.iter().all(|&value| unsafe {
+        // FFI write -> direct read.
+        let variant =
+            Variant::from_var_sys_init(|variant_ptr| to_variant(variant_ptr, value.sys()));
+        let ffi_tag = interface_fn!(variant_get_type)(variant.var_sys());
+        if read_tag(&variant) != ffi_tag || read::<T>(&variant) != Some(value) {
+            return false;
+        }
+
+        // Direct write -> FFI read.
+        let variant = Variant::from_var_sys_init(|variant_ptr| write(variant_ptr, value));
+        let ffi_tag = interface_fn!(variant_get_type)(variant.var_sys());
+        let ffi_value =
+            T::from_sys_init_default(|type_ptr| from_variant(type_ptr, variant.var_sys()));
+
+        ffi_tag == T::TAG && ffi_value == value
+    })
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Type whose variant payload is plain data, stored as `Payload` at [`PAYLOAD_OFFSET`].
+pub(super) trait PodVariant: Copy {
+    const TAG: sys::GDExtensionVariantType;
+    type Payload: Copy;
+
+    fn to_payload(self) -> Self::Payload;
+    fn from_payload(payload: Self::Payload) -> Self;
+}
+
+impl PodVariant for bool {
+    const TAG: sys::GDExtensionVariantType = sys::GDEXTENSION_VARIANT_TYPE_BOOL;
+
+    // C++ bool is stored as one byte; read as integer so that unexpected bit patterns cannot produce an invalid Rust bool.
+    type Payload = u8;
+
+    fn to_payload(self) -> u8 {
+        self as u8
+    }
+
+    fn from_payload(payload: u8) -> Self {
+        payload != 0
+    }
+}
+
+macro_rules! impl_pod_variant {
+    ($T:ty, $tag:ident) => {
+        impl PodVariant for $T {
+            const TAG: sys::GDExtensionVariantType = sys::$tag;
+            type Payload = $T;
+
+            fn to_payload(self) -> Self {
+                self
+            }
+
+            fn from_payload(payload: Self) -> Self {
+                payload
+            }
+        }
+    };
+}
+
+impl_pod_variant!(i64, GDEXTENSION_VARIANT_TYPE_INT);
+impl_pod_variant!(f64, GDEXTENSION_VARIANT_TYPE_FLOAT);
+impl_pod_variant!(Vector2, GDEXTENSION_VARIANT_TYPE_VECTOR2);
+
+/// Reads the type tag of `variant`.
+///
+/// # Safety
+/// The layout must have been verified, see [`is_enabled()`].
+#[inline(always)]
+pub(super) unsafe fn read_tag(variant: &Variant) -> sys::GDExtensionVariantType {
+    let base = variant as *const Variant as *const u8;
+    ptr::read(base.add(TAG_OFFSET) as *const sys::GDExtensionVariantType)
+}
+
+/// Reads the value of `variant`, or `None` if it holds a different type.
+///
+/// # Safety
+/// The layout must have been verified, see [`is_enabled()`].
+#[inline(always)]
+pub(super) unsafe fn read<T: PodVariant>(variant: &Variant) -> Option<T> {
+    if read_tag(variant) != T::TAG {
+        return None;
+    }
+
+    let base = variant as *const Variant as *const u8;
+    let payload = ptr::read_unaligned(base.add(PAYLOAD_OFFSET) as *const T::Payload);
+    Some(T::from_payload(payload))
+}
+
+/// Initializes the variant at `dst` with `value`.
+///
+/// # Safety
+/// The layout must have been verified, see [`is_enabled()`]. `dst` must point to uninitialized or nil/POD variant memory,
+/// since no destructor is run.
+#[inline(always)]
+pub(super) unsafe fn write<T: PodVariant>(dst: sys::GDExtensionVariantPtr, value: T) {
+    let base = dst as *mut u8;
+
+    // Zero the rest of the union as well, so that no stale bytes of a previous value remain.
+    ptr::write_bytes(base, 0, size_of::<OpaqueVariant>());
+    ptr::write(
+        base.add(TAG_OFFSET) as *mut sys::GDExtensionVariantType,
+        T::TAG,
+    );
+    ptr::write_unaligned(
+        base.add(PAYLOAD_OFFSET) as *mut T::Payload,
+        value.to_payload(),
+    );
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn bool_payload() {
+        assert_eq!(true.to_payload(), 1);
+        assert_eq!(false.to_payload(), 0);
+        assert!(bool::from_payload(2));
+        assert!(!bool::from_payload(0));
+    }
+}
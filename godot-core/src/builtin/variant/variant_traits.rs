@@ -6,6 +6,7 @@
  */
 
 use crate::builtin::Variant;
+use godot_ffi as sys;
 
 /// Trait to enable conversions of types _from_ the [`Variant`] type.
 pub trait FromVariant: Sized {
@@ -46,6 +47,22 @@ pub trait ToVariant {
     ///
     /// This method must not panic. If your conversion is fallible, this trait should not be used.
     fn to_variant(&self) -> Variant;
+
+    /// Moves `self` into the variant pointed to by `dst`, e.g. the return slot of a varcall.
+    ///
+    /// Types with a direct Godot converter construct the variant in place, skipping the temporary `Variant`.
+    ///
+    /// # Safety
+    /// `dst` must point to an uninitialized or nil variant. Its previous value is overwritten without being destroyed.
+    #[doc(hidden)]
+    unsafe fn move_into_var_sys(self, dst: sys::GDExtensionVariantPtr)
+    where
+        Self: Sized,
+    {
+        let variant = self.to_variant();
+        variant.write_var_sys(dst);
+        std::mem::forget(variant);
+    }
 }
 
 // ----------------------------------------------------------------------------------------------------------------------------------------------
@@ -16,7 +16,8 @@ use crate::builtin::Vector3i;
 
 use super::glam_helpers::GlamConv;
 use super::glam_helpers::GlamType;
-use super::{real, RVec3};
+use super::soa::{self, Vector3x4};
+use super::{real, RVec3, RVec4};
 
 /// Vector used for 3D math using floating point coordinates.
 ///
@@ -211,10 +212,51 @@ impl Vector3 {
         Self::from_glam(self.to_glam().lerp(to.to_glam(), weight))
     }
 
+    /// Linearly interpolates each element of `values` towards the element at the same index in `to`, in place.
+    ///
+    /// Same result as `*value = value.lerp(to, weight)` for each pair, but processes several elements at a time.
+    ///
+    /// # Panics
+    /// If `values` and `to` have different lengths.
+    pub fn lerp_slice(values: &mut [Self], to: &[Self], weight: real) {
+        soa::zip_in_place(
+            values,
+            to,
+            |v, to| v.lerp(to, weight),
+            |v, to| v.lerp(to, weight),
+        );
+    }
+
     pub fn limit_length(self, length: Option<real>) -> Self {
         Self::from_glam(self.to_glam().clamp_length_max(length.unwrap_or(1.0)))
     }
 
+    /// Normalizes all `values` in place, with the same result as `*value = value.normalized()` for each element.
+    ///
+    /// Like [`normalized()`](Self::normalized), vectors which cannot be normalized (e.g. zero) become zero.
+    pub fn normalize_slice(values: &mut [Self]) {
+        soa::map_in_place(
+            values,
+            |v| {
+                let recip = v
+                    .length_squared()
+                    .to_array()
+                    .map(|len_sq| 1.0 / len_sq.sqrt());
+                let recip = RVec4::from(recip);
+
+                // Same condition as glam's `normalize_or_zero()`; NaN compares false and is excluded as well.
+                let valid = recip.cmpgt(RVec4::ZERO) & recip.cmplt(RVec4::splat(real::INFINITY));
+
+                Vector3x4 {
+                    x: RVec4::select(valid, v.x * recip, RVec4::ZERO),
+                    y: RVec4::select(valid, v.y * recip, RVec4::ZERO),
+                    z: RVec4::select(valid, v.z * recip, RVec4::ZERO),
+                }
+            },
+            Self::normalized,
+        );
+    }
+
     pub fn max_axis_index(self) -> Vector3Axis {
         if self.x < self.y {
             if self.y < self.z {
@@ -0,0 +1,786 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Memory-mapped binary datasets.
+//!
+//! Large precomputed data (navigation grids, lookup tables, ...) is often loaded through Godot resources, which means
+//! parsing the file and then copying every element into a packed array. A [`Dataset`] instead reads or memory-maps a
+//! binary file and validates its header once. The arrays it contains are then available as slices directly borrowed
+//! from the dataset (no copy at all), or as packed arrays built with a single bulk copy through `From<&[T]>`.
+//!
+//! [`Dataset::open()`] reads the file with one bulk copy. [`Dataset::open_mapped()`] avoids even that by mapping the
+//! file, but is `unsafe`, since the file must then stay unmodified while the dataset is in use.
+//!
+//! Datasets are produced with [`DatasetWriter`], e.g. in a build script or an editor tool:
+//! ```no_run
+//! use godot::dataset::{Dataset, DatasetWriter};
+//!
+//! let heights: Vec<f32> = (0..1024 * 1024).map(|i| (i % 7) as f32).collect();
+//! DatasetWriter::new()
+//!     .add("heights", &heights)
+//!     .write_to("terrain.gdxd")
+//!     .unwrap();
+//!
+//! // SAFETY: the file is not modified while `dataset` is alive.
+//! let dataset = unsafe { Dataset::open_mapped("terrain.gdxd") }.unwrap();
+//! let slice: &[f32] = dataset.slice("heights").unwrap(); // zero-copy
+//! let packed = dataset.packed_array::<f32>("heights").unwrap(); // one memcpy
+//! assert_eq!(slice.len(), packed.len());
+//! ```
+//!
+//! # File format (version 1)
+//! All integers are little-endian.
+//!
+//! | Part    | Layout                                                                                          |
+//! |---------|-------------------------------------------------------------------------------------------------|
+//! | Header  | magic `b"GDXD"`, version `u32`, entry count `u32`, reserved `u32` (0)                           |
+//! | Entries | per entry: element type `u32`, element size `u32`, name offset `u32`, name length `u32`,       |
+//! |         | data offset `u64`, element count `u64`                                                          |
+//! | Names   | UTF-8, not null-terminated                                                                      |
+//! | Data    | contiguous elements in native (`#[repr(C)]`) layout, each array aligned to 16 bytes            |
+//!
+//! Vector types store `real` components, so their element size depends on the `double-precision` feature. Loading a
+//! file written with a different precision fails with [`DatasetError::Malformed`] instead of misinterpreting data.
+
+use std::collections::HashSet;
+use std::fmt;
+use std::fs::File;
+use std::io::{self, Read, Write};
+use std::mem;
+use std::path::Path;
+
+use crate::builtin::meta::VariantMetadata;
+use crate::builtin::*;
+
+const MAGIC: [u8; 4] = *b"GDXD";
+const VERSION: u32 = 1;
+
+const HEADER_SIZE: usize = 16;
+const ENTRY_SIZE: usize = 32;
+
+/// Alignment of every array in the file; a multiple of each element type's alignment.
+const DATA_ALIGN: usize = 16;
+
+/// Type of the elements of one array in a [`Dataset`].
+#[derive(Copy, Clone, Eq, PartialEq, Hash, Debug)]
+#[repr(u32)]
+pub enum ElementType {
+    Byte = 1,
+    Int32 = 2,
+    Int64 = 3,
+    Float32 = 4,
+    Float64 = 5,
+    Vector2 = 6,
+    Vector3 = 7,
+    Color = 8,
+}
+
+impl ElementType {
+    fn from_ord(ord: u32) -> Option<Self> {
+        let ty = match ord {
+            1 => Self::Byte,
+            2 => Self::Int32,
+            3 => Self::Int64,
+            4 => Self::Float32,
+            5 => Self::Float64,
+            6 => Self::Vector2,
+            7 => Self::Vector3,
+            8 => Self::Color,
+            _ => return None,
+        };
+        Some(ty)
+    }
+
+    /// Size of one element in this build.
+    fn size(self) -> usize {
+        match self {
+            Self::Byte => mem::size_of::<u8>(),
+            Self::Int32 => mem::size_of::<i32>(),
+            Self::Int64 => mem::size_of::<i64>(),
+            Self::Float32 => mem::size_of::<f32>(),
+            Self::Float64 => mem::size_of::<f64>(),
+            Self::Vector2 => mem::size_of::<Vector2>(),
+            Self::Vector3 => mem::size_of::<Vector3>(),
+            Self::Color => mem::size_of::<Color>(),
+        }
+    }
+}
+
+/// Element type that can be stored in a [`Dataset`].
+///
+/// # Safety
+/// Every bit pattern of `size_of::<Self>()` bytes must be a valid value, and the type must not contain padding.
+pub unsafe trait DatasetElement: Copy + 'static {
+    const ELEMENT_TYPE: ElementType;
+
+    /// Packed array holding this element type.
+    type PackedArray: for<'a> From<&'a [Self]>;
+}
+
+macro_rules! impl_dataset_element {
+    ($T:ty, $ElementType:ident, $PackedArray:ident) => {
+        unsafe impl DatasetElement for $T {
+            const ELEMENT_TYPE: ElementType = ElementType::$ElementType;
+            type PackedArray = $PackedArray;
+        }
+    };
+}
+
+impl_dataset_element!(u8, Byte, PackedByteArray);
+impl_dataset_element!(i32, Int32, PackedInt32Array);
+impl_dataset_element!(i64, Int64, PackedInt64Array);
+impl_dataset_element!(f32, Float32, PackedFloat32Array);
+impl_dataset_element!(f64, Float64, PackedFloat64Array);
+impl_dataset_element!(Vector2, Vector2, PackedVector2Array);
+impl_dataset_element!(Vector3, Vector3, PackedVector3Array);
+impl_dataset_element!(Color, Color, PackedColorArray);
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Errors
+
+/// Error while opening or accessing a [`Dataset`].
+#[derive(Debug)]
+pub enum DatasetError {
+    /// The file could not be read or mapped.
+    Io(io::Error),
+
+    /// The file is not a valid dataset: wrong magic, truncated, or inconsistent header.
+    Malformed(String),
+
+    /// The file was written by a newer format version.
+    UnsupportedVersion(u32),
+
+    /// No array with this name exists in the dataset.
+    NotFound(String),
+
+    /// The array exists, but holds a different element type than requested.
+    TypeMismatch {
+        name: String,
+        expected: ElementType,
+        actual: ElementType,
+    },
+}
+
+impl fmt::Display for DatasetError {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        match self {
+            Self::Io(err) => write!(f, "dataset I/O error: {err}"),
+            Self::Malformed(reason) => write!(f, "malformed dataset: {reason}"),
+            Self::UnsupportedVersion(version) => write!(
+                f,
+                "dataset has format version {version}, but only version {VERSION} is supported"
+            ),
+            Self::NotFound(name) => write!(f, "dataset has no array named '{name}'"),
+            Self::TypeMismatch {
+                name,
+                expected,
+                actual,
+            } => write!(
+                f,
+                "dataset array '{name}' holds {actual:?} elements, not {expected:?}"
+            ),
+        }
+    }
+}
+
+impl std::error::Error for DatasetError {
+    fn source(&self) -> Option<&(dyn std::error::Error + 'static)> {
+        match self {
+            Self::Io(err) => Some(err),
+            _ => None,
+        }
+    }
+}
+
+impl From<io::Error> for DatasetError {
+    fn from(err: io::Error) -> Self {
+        Self::Io(err)
+    }
+}
+
+fn malformed<T>(reason: impl Into<String>) -> Result<T, DatasetError> {
+    Err(DatasetError::Malformed(reason.into()))
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Reading
+
+/// Read-only collection of named arrays, backed by a memory-mapped file (or an owned buffer).
+///
+/// See the [module documentation](self) for an example and the file format.
+pub struct Dataset {
+    storage: Storage,
+    entries: Vec<Entry>,
+}
+
+#[derive(Debug)]
+struct Entry {
+    name: String,
+    element_type: ElementType,
+    offset: usize,
+    len: usize,
+}
+
+impl Dataset {
+    /// Reads the file at `path` into memory and validates its header.
+    ///
+    /// The whole file is read with one bulk copy into an aligned buffer; afterwards, the dataset is independent of the
+    /// file. To avoid this copy, see [`open_mapped()`][Self::open_mapped].
+    pub fn open(path: impl AsRef<Path>) -> Result<Self, DatasetError> {
+        let file = File::open(path)?;
+        Self::from_storage(Storage::read_file(file)?)
+    }
+
+    /// Maps the file at `path` into memory and validates its header.
+    ///
+    /// On Unix, the data is paged in lazily by the OS when accessed; no array is copied until requested. On other
+    /// platforms, this behaves like [`open()`][Self::open].
+    ///
+    /// # Safety
+    /// The file must not be modified or truncated, by this or any other process, while the dataset is alive. Slices
+    /// returned by [`slice()`][Self::slice] point directly into the mapping, so modifications would change the contents
+    /// of immutable borrows, and truncation makes accesses fault (`SIGBUS`).
+    pub unsafe fn open_mapped(path: impl AsRef<Path>) -> Result<Self, DatasetError> {
+        let file = File::open(path)?;
+        Self::from_storage(Storage::map_file(file)?)
+    }
+
+    /// Parses a dataset from an in-memory buffer, e.g. one obtained through `FileAccess` for paths within the PCK.
+    ///
+    /// The buffer is copied once, to guarantee the alignment needed for zero-copy slices.
+    pub fn from_bytes(bytes: &[u8]) -> Result<Self, DatasetError> {
+        Self::from_storage(Storage::from_bytes(bytes))
+    }
+
+    fn from_storage(storage: Storage) -> Result<Self, DatasetError> {
+        let entries = parse(storage.as_bytes())?;
+        Ok(Self { storage, entries })
+    }
+
+    /// Names of all arrays, in file order.
+    pub fn names(&self) -> impl Iterator<Item = &str> {
+        self.entries.iter().map(|entry| entry.name.as_str())
+    }
+
+    /// Element type of the array named `name`, if it exists.
+    pub fn element_type(&self, name: &str) -> Option<ElementType> {
+        self.find(name).map(|entry| entry.element_type)
+    }
+
+    /// Borrows the array named `name` directly from the dataset's memory, without copying.
+    pub fn slice<T: DatasetElement>(&self, name: &str) -> Result<&[T], DatasetError> {
+        let entry = self.typed_entry::<T>(name)?;
+        let bytes = &self.storage.as_bytes()[entry.offset..][..entry.len * mem::size_of::<T>()];
+
+        let ptr = bytes.as_ptr();
+        if ptr as usize % mem::align_of::<T>() != 0 {
+            // Cannot happen for mapped or owned storage (both are at least 8-byte aligned), but checked for soundness.
+            return malformed(format!("array '{name}' is misaligned in memory"));
+        }
+
+        // SAFETY: bounds were validated on open, alignment just now; `DatasetElement` guarantees any bit pattern is valid.
+        Ok(unsafe { std::slice::from_raw_parts(ptr as *const T, entry.len) })
+    }
+
+    /// Copies the array named `name` into a new packed array, with a single bulk copy.
+    ///
+    /// The element type selects the packed array, e.g. `packed_array::<f32>()` returns a `PackedFloat32Array`.
+    pub fn packed_array<T: DatasetElement>(
+        &self,
+        name: &str,
+    ) -> Result<T::PackedArray, DatasetError> {
+        self.slice::<T>(name).map(T::PackedArray::from)
+    }
+
+    /// Copies the array named `name` into a new typed array.
+    ///
+    /// Unlike [`packed_array()`][Self::packed_array], this converts each element to a `Variant`.
+    pub fn array<T>(&self, name: &str) -> Result<Array<T>, DatasetError>
+    where
+        T: DatasetElement + VariantMetadata + ToVariant,
+    {
+        self.slice::<T>(name).map(Array::from)
+    }
+
+    /// Copies all arrays into a dictionary, mapping each name to its packed array.
+    pub fn to_dictionary(&self) -> Dictionary {
+        let mut dict = Dictionary::new();
+        for entry in &self.entries {
+            let name = entry.name.as_str();
+            let value = match entry.element_type {
+                ElementType::Byte => self.packed_variant::<u8>(name),
+                ElementType::Int32 => self.packed_variant::<i32>(name),
+                ElementType::Int64 => self.packed_variant::<i64>(name),
+                ElementType::Float32 => self.packed_variant::<f32>(name),
+                ElementType::Float64 => self.packed_variant::<f64>(name),
+                ElementType::Vector2 => self.packed_variant::<Vector2>(name),
+                ElementType::Vector3 => self.packed_variant::<Vector3>(name),
+                ElementType::Color => self.packed_variant::<Color>(name),
+            };
+            dict.insert(name, value);
+        }
+        dict
+    }
+
+    fn packed_variant<T>(&self, name: &str) -> Variant
+    where
+        T: DatasetElement,
+        T::PackedArray: ToVariant,
+    {
+        self.packed_array::<T>(name)
+            .expect("entry was validated on open")
+            .to_variant()
+    }
+
+    fn find(&self, name: &str) -> Option<&Entry> {
+        self.entries.iter().find(|entry| entry.name == name)
+    }
+
+    fn typed_entry<T: DatasetElement>(&self, name: &str) -> Result<&Entry, DatasetError> {
+        let entry = self
+            .find(name)
+            .ok_or_else(|| DatasetError::NotFound(name.to_string()))?;
+
+        if entry.element_type != T::ELEMENT_TYPE {
+            return Err(DatasetError::TypeMismatch {
+                name: name.to_string(),
+                expected: T::ELEMENT_TYPE,
+                actual: entry.element_type,
+            });
+        }
+
+        Ok(entry)
+    }
+}
+
+impl fmt::Debug for Dataset {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("Dataset")
+            .field("size", &self.storage.as_bytes().len())
+            .field("entries", &self.entries)
+            .finish()
+    }
+}
+
+/// Validates header and entry table of `bytes`.
+fn parse(bytes: &[u8]) -> Result<Vec<Entry>, DatasetError> {
+    if cfg!(target_endian = "big") {
+        return malformed("datasets are little-endian, big-endian hosts are not supported");
+    }
+
+    if bytes.len() < HEADER_SIZE {
+        return malformed("file is smaller than the header");
+    }
+    if bytes[0..4] != MAGIC {
+        return malformed("wrong magic number");
+    }
+
+    let version = read_u32(bytes, 4);
+    if version != VERSION {
+        return Err(DatasetError::UnsupportedVersion(version));
+    }
+
+    let entry_count = read_u32(bytes, 8) as usize;
+    let table_end = entry_count
+        .checked_mul(ENTRY_SIZE)
+        .and_then(|size| size.checked_add(HEADER_SIZE))
+        .filter(|&end| end <= bytes.len());
+    if table_end.is_none() {
+        return malformed("entry table exceeds file size");
+    }
+
+    let mut entries = Vec::with_capacity(entry_count);
+    let mut names = HashSet::with_capacity(entry_count);
+    for i in 0..entry_count {
+        let at = HEADER_SIZE + i * ENTRY_SIZE;
+        let entry = parse_entry(bytes, at)?;
+
+        if !names.insert(entry.name.clone()) {
+            return malformed(format!("duplicate array name '{}'", entry.name));
+        }
+        entries.push(entry);
+    }
+
+    Ok(entries)
+}
+
+fn parse_entry(bytes: &[u8], at: usize) -> Result<Entry, DatasetError> {
+    let type_ord = read_u32(bytes, at);
+    let element_size = read_u32(bytes, at + 4) as usize;
+    let name_offset = read_u32(bytes, at + 8) as usize;
+    let name_len = read_u32(bytes, at + 12) as usize;
+    let data_offset = read_u64(bytes, at + 16);
+    let element_count = read_u64(bytes, at + 24);
+
+    let name = match name_offset
+        .checked_add(name_len)
+        .and_then(|end| bytes.get(name_offset..end))
+    {
+        Some(name) => std::str::from_utf8(name)
+            .map_err(|_| DatasetError::Malformed("array name is not valid UTF-8".to_string()))?,
+        None => return malformed("array name exceeds file size"),
+    };
+
+    let element_type = match ElementType::from_ord(type_ord) {
+        Some(ty) => ty,
+        None => {
+            return malformed(format!(
+                "array '{name}' has unknown element type {type_ord}"
+            ))
+        }
+    };
+
+    if element_size != element_type.size() {
+        return malformed(format!(
+            "array '{name}' has {element_type:?} elements of {element_size} bytes, expected {} \
+            (file written with different `double-precision` setting?)",
+            element_type.size()
+        ));
+    }
+
+    let (offset, len) = match (usize::try_from(data_offset), usize::try_from(element_count)) {
+        (Ok(offset), Ok(len)) => (offset, len),
+        _ => return malformed(format!("array '{name}' exceeds address space")),
+    };
+
+    let in_bounds = len
+        .checked_mul(element_size)
+        .and_then(|size| size.checked_add(offset))
+        .map_or(false, |end| end <= bytes.len());
+    if !in_bounds {
+        return malformed(format!("array '{name}' exceeds file size"));
+    }
+    if offset % DATA_ALIGN != 0 {
+        return malformed(format!(
+            "array '{name}' is not aligned to {DATA_ALIGN} bytes"
+        ));
+    }
+
+    Ok(Entry {
+        name: name.to_string(),
+        element_type,
+        offset,
+        len,
+    })
+}
+
+fn read_u32(bytes: &[u8], at: usize) -> u32 {
+    u32::from_le_bytes(bytes[at..at + 4].try_into().unwrap())
+}
+
+fn read_u64(bytes: &[u8], at: usize) -> u64 {
+    u64::from_le_bytes(bytes[at..at + 8].try_into().unwrap())
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Writing
+
+/// Builds a dataset file from named arrays.
+#[derive(Default)]
+pub struct DatasetWriter {
+    arrays: Vec<PendingArray>,
+}
+
+struct PendingArray {
+    name: String,
+    element_type: ElementType,
+    element_size: usize,
+    len: usize,
+    data: Vec<u8>,
+}
+
+impl DatasetWriter {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Adds an array named `name`. Names must be unique within a dataset.
+    ///
+    /// # Panics
+    /// If an array named `name` was already added.
+    pub fn add<T: DatasetElement>(&mut self, name: &str, data: &[T]) -> &mut Self {
+        assert!(
+            self.arrays.iter().all(|array| array.name != name),
+            "dataset already contains an array named '{name}'"
+        );
+
+        // SAFETY: `DatasetElement` types have no padding, so all bytes are initialized.
+        let bytes = unsafe {
+            std::slice::from_raw_parts(data.as_ptr() as *const u8, mem::size_of_val(data))
+        };
+
+        self.arrays.push(PendingArray {
+            name: name.to_string(),
+            element_type: T::ELEMENT_TYPE,
+            element_size: mem::size_of::<T>(),
+            len: data.len(),
+            data: bytes.to_vec(),
+        });
+        self
+    }
+
+    /// Serializes all added arrays.
+    pub fn to_bytes(&self) -> Vec<u8> {
+        let table_end = HEADER_SIZE + self.arrays.len() * ENTRY_SIZE;
+        let names_size: usize = self.arrays.iter().map(|array| array.name.len()).sum();
+
+        let mut data_offset = align_up(table_end + names_size);
+        let mut entries = Vec::with_capacity(self.arrays.len() * ENTRY_SIZE);
+        let mut names: Vec<u8> = Vec::with_capacity(names_size);
+        for array in &self.arrays {
+            entries.extend((array.element_type as u32).to_le_bytes());
+            entries.extend((array.element_size as u32).to_le_bytes());
+            entries.extend(((table_end + names.len()) as u32).to_le_bytes());
+            entries.extend((array.name.len() as u32).to_le_bytes());
+            entries.extend((data_offset as u64).to_le_bytes());
+            entries.extend((array.len as u64).to_le_bytes());
+
+            names.extend(array.name.as_bytes());
+            data_offset = align_up(data_offset + array.data.len());
+        }
+
+        let mut bytes = Vec::with_capacity(data_offset);
+        bytes.extend(MAGIC);
+        bytes.extend(VERSION.to_le_bytes());
+        bytes.extend((self.arrays.len() as u32).to_le_bytes());
+        bytes.extend(0u32.to_le_bytes());
+        bytes.extend(entries);
+        bytes.extend(names);
+        for array in &self.arrays {
+            bytes.resize(align_up(bytes.len()), 0);
+            bytes.extend(&array.data);
+        }
+
+        bytes
+    }
+
+    /// Writes the dataset to the file at `path`, replacing it if it exists.
+    pub fn write_to(&self, path: impl AsRef<Path>) -> io::Result<()> {
+        File::create(path)?.write_all(&self.to_bytes())
+    }
+}
+
+fn align_up(offset: usize) -> usize {
+    (offset + DATA_ALIGN - 1) / DATA_ALIGN * DATA_ALIGN
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Storage
+
+enum Storage {
+    #[cfg(unix)]
+    Mapped(mmap::Mmap),
+
+    // `u64` elements, so that the buffer is 8-byte aligned like the largest element types.
+    Owned {
+        buffer: Vec<u64>,
+        len: usize,
+    },
+}
+
+impl Storage {
+    /// # Safety
+    /// See [`Dataset::open_mapped()`].
+    unsafe fn map_file(file: File) -> io::Result<Self> {
+        #[cfg(unix)]
+        if let Some(map) = mmap::Mmap::map(&file)? {
+            return Ok(Self::Mapped(map));
+        }
+
+        Self::read_file(file)
+    }
+
+    fn read_file(mut file: File) -> io::Result<Self> {
+        let len = usize::try_from(file.metadata()?.len())
+            .map_err(|_| io::Error::new(io::ErrorKind::InvalidData, "file too large to read"))?;
+
+        // Read directly into the aligned buffer, so that the file contents are copied only once.
+        let mut buffer = Self::aligned_buffer(len);
+        // SAFETY: `buffer` spans at least `len` bytes, and any byte pattern is a valid `u64`.
+        let bytes = unsafe { std::slice::from_raw_parts_mut(buffer.as_mut_ptr() as *mut u8, len) };
+        file.read_exact(bytes)?;
+
+        Ok(Self::Owned { buffer, len })
+    }
+
+    fn from_bytes(bytes: &[u8]) -> Self {
+        let mut buffer = Self::aligned_buffer(bytes.len());
+
+        // SAFETY: `buffer` spans at least `bytes.len()` bytes, and any byte pattern is a valid `u64`.
+        unsafe {
+            std::ptr::copy_nonoverlapping(
+                bytes.as_ptr(),
+                buffer.as_mut_ptr() as *mut u8,
+                bytes.len(),
+            );
+        }
+
+        Self::Owned {
+            buffer,
+            len: bytes.len(),
+        }
+    }
+
+    fn aligned_buffer(len: usize) -> Vec<u64> {
+        vec![0u64; (len + 7) / 8]
+    }
+
+    fn as_bytes(&self) -> &[u8] {
+        match self {
+            #[cfg(unix)]
+            Self::Mapped(map) => map.as_bytes(),
+            Self::Owned { buffer, len } => {
+                // SAFETY: `buffer` holds at least `len` initialized bytes.
+                unsafe { std::slice::from_raw_parts(buffer.as_ptr() as *const u8, *len) }
+            }
+        }
+    }
+}
+
+#[cfg(unix)]
+mod mmap {
+    use std::fs::File;
+    use std::io;
+    use std::os::unix::io::AsRawFd;
+    use std::ptr;
+
+    /// Read-only, private mapping of a whole file.
+    pub(super) struct Mmap {
+        ptr: *mut libc::c_void,
+        len: usize,
+    }
+
+    // SAFETY: the mapping is read-only and owned exclusively by this value.
+    unsafe impl Send for Mmap {}
+    unsafe impl Sync for Mmap {}
+
+    impl Mmap {
+        /// Maps `file`, or returns `None` if it is empty (zero-length mappings are not allowed).
+        pub fn map(file: &File) -> io::Result<Option<Self>> {
+            let len = usize::try_from(file.metadata()?.len())
+                .map_err(|_| io::Error::new(io::ErrorKind::InvalidData, "file too large to map"))?;
+            if len == 0 {
+                return Ok(None);
+            }
+
+            let ptr = unsafe {
+                libc::mmap(
+                    ptr::null_mut(),
+                    len,
+                    libc::PROT_READ,
+                    libc::MAP_PRIVATE,
+                    file.as_raw_fd(),
+                    0,
+                )
+            };
+            if ptr == libc::MAP_FAILED {
+                return Err(io::Error::last_os_error());
+            }
+
+            Ok(Some(Self { ptr, len }))
+        }
+
+        pub fn as_bytes(&self) -> &[u8] {
+            // SAFETY: the mapping is valid for `len` bytes until dropped.
+            unsafe { std::slice::from_raw_parts(self.ptr as *const u8, self.len) }
+        }
+    }
+
+    impl Drop for Mmap {
+        fn drop(&mut self) {
+            unsafe {
+                libc::munmap(self.ptr, self.len);
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sample() -> Vec<u8> {
+        DatasetWriter::new()
+            .add("bytes", &[1u8, 2, 3])
+            .add("floats", &[0.5f32, -1.0, 2.25, 8.0])
+            .add("ints", &[i64::MIN, 0, i64::MAX])
+            .to_bytes()
+    }
+
+    #[test]
+    fn roundtrip() {
+        let dataset = Dataset::from_bytes(&sample()).unwrap();
+
+        assert_eq!(
+            dataset.names().collect::<Vec<_>>(),
+            ["bytes", "floats", "ints"]
+        );
+        assert_eq!(dataset.element_type("floats"), Some(ElementType::Float32));
+        assert_eq!(dataset.slice::<u8>("bytes").unwrap(), [1, 2, 3]);
+        assert_eq!(
+            dataset.slice::<f32>("floats").unwrap(),
+            [0.5, -1.0, 2.25, 8.0]
+        );
+        assert_eq!(
+            dataset.slice::<i64>("ints").unwrap(),
+            [i64::MIN, 0, i64::MAX]
+        );
+    }
+
+    #[test]
+    fn lookup_errors() {
+        let dataset = Dataset::from_bytes(&sample()).unwrap();
+
+        assert!(matches!(
+            dataset.slice::<u8>("missing"),
+            Err(DatasetError::NotFound(_))
+        ));
+        assert!(matches!(
+            dataset.slice::<f64>("floats"),
+            Err(DatasetError::TypeMismatch {
+                expected: ElementType::Float64,
+                actual: ElementType::Float32,
+                ..
+            })
+        ));
+    }
+
+    #[test]
+    fn invalid_headers() {
+        let bytes = sample();
+
+        let mut wrong_magic = bytes.clone();
+        wrong_magic[0] = b'X';
+        assert!(matches!(
+            Dataset::from_bytes(&wrong_magic),
+            Err(DatasetError::Malformed(_))
+        ));
+
+        let mut newer = bytes.clone();
+        newer[4..8].copy_from_slice(&2u32.to_le_bytes());
+        assert!(matches!(
+            Dataset::from_bytes(&newer),
+            Err(DatasetError::UnsupportedVersion(2))
+        ));
+
+        let truncated = &bytes[..bytes.len() - 1];
+        assert!(matches!(
+            Dataset::from_bytes(truncated),
+            Err(DatasetError::Malformed(_))
+        ));
+
+        let mut huge_count = bytes;
+        huge_count[8..12].copy_from_slice(&u32::MAX.to_le_bytes());
+        assert!(matches!(
+            Dataset::from_bytes(&huge_count),
+            Err(DatasetError::Malformed(_))
+        ));
+
+        assert!(Dataset::from_bytes(&[]).is_err());
+    }
+}
@@ -0,0 +1,384 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Deferred engine calls and signal futures.
+//!
+//! Most engine APIs may only be used on the main thread. [`CommandBuffer`] lets other threads record calls on objects
+//! (identified by [`InstanceId`]), which are then applied in one batch on the main thread. [`SignalFuture`] goes the other
+//! way round: it is an `async`-style future that completes once a Godot signal is emitted.
+
+use std::future::Future;
+use std::mem;
+use std::panic::AssertUnwindSafe;
+use std::pin::Pin;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::Mutex;
+use std::task::{Context, Poll, Waker};
+use std::thread::{self, ThreadId};
+
+use godot_ffi as sys;
+use once_cell::sync::OnceCell;
+use sys::interface_fn;
+
+use crate::builtin::{Callable, StringName, Variant};
+use crate::engine::{object, Object, RefCounted};
+use crate::obj::{cap, dom, Base, EngineEnum, Gd, GodotClass, Inherits, InstanceId, Share};
+
+static MAIN_THREAD: OnceCell<ThreadId> = OnceCell::new();
+
+/// Remembers the calling thread as the main thread. Called during library initialization.
+pub(crate) fn initialize() {
+    let _ = MAIN_THREAD.set(thread::current().id());
+}
+
+/// Called during library deinitialization, after which Godot no longer knows the receiver class.
+pub(crate) fn deinitialize() {
+    RECEIVER_REGISTERED.store(false, Ordering::Relaxed);
+}
+
+/// Whether the current thread is the one that loaded the extension library.
+pub fn is_main_thread() -> bool {
+    MAIN_THREAD
+        .get()
+        .map_or(true, |main| *main == thread::current().id())
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Command buffer
+
+type Command = Box<dyn FnOnce() -> bool + Send>;
+
+/// Records engine calls from any thread, to be applied later on the main thread.
+///
+/// A command is a closure that receives the target object as `Gd<T>`. Inside, regular generated engine methods are called,
+/// which use their cached method binds and ptrcalls -- so a flushed command costs the same as an immediate call, minus
+/// the locking that would otherwise be needed per call.
+///
+/// The buffer is usually a `static`, filled by worker threads and flushed once per frame, e.g. in `process()`:
+/// ```no_run
+/// # use godot::prelude::*;
+/// use godot::deferred::CommandBuffer;
+///
+/// static UPDATES: CommandBuffer = CommandBuffer::new();
+///
+/// fn simulate(node_id: InstanceId) {
+///     // Any thread.
+///     UPDATES.record(node_id, |mut node: Gd<Node3D>| {
+///         node.set_position(Vector3::new(1.0, 2.0, 3.0));
+///     });
+/// }
+///
+/// fn process() {
+///     // Main thread.
+///     UPDATES.flush();
+/// }
+/// ```
+pub struct CommandBuffer {
+    commands: Mutex<Vec<Command>>,
+}
+
+impl CommandBuffer {
+    pub const fn new() -> Self {
+        Self {
+            commands: Mutex::new(Vec::new()),
+        }
+    }
+
+    /// Records `command`, to be run on the object with ID `instance_id` during the next [`flush()`][Self::flush].
+    ///
+    /// If the object no longer exists or is not of class `T` (or derived) by then, the command is skipped.
+    pub fn record<T, F>(&self, instance_id: InstanceId, command: F)
+    where
+        T: GodotClass,
+        F: FnOnce(Gd<T>) + Send + 'static,
+    {
+        let command: Command = Box::new(move || match Gd::<T>::try_from_instance_id(instance_id) {
+            Some(obj) => {
+                command(obj);
+                true
+            }
+            None => false,
+        });
+
+        self.lock().push(command);
+    }
+
+    /// Number of recorded commands, which have not yet been flushed.
+    pub fn len(&self) -> usize {
+        self.lock().len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Runs all recorded commands in recording order.
+    ///
+    /// The lock is only held to take the recorded commands out, so other threads can keep recording meanwhile; such
+    /// commands are run by the next flush. Commands recorded by commands themselves are deferred the same way.
+    ///
+    /// A panicking command is reported to Godot and counted in [`FlushStats::panicked`]; the remaining commands still run.
+    ///
+    /// # Panics
+    /// If not called on the main thread.
+    pub fn flush(&self) -> FlushStats {
+        assert!(
+            is_main_thread(),
+            "CommandBuffer::flush() must be called on the main thread"
+        );
+
+        let commands = mem::take(&mut *self.lock());
+
+        let mut stats = FlushStats::default();
+        for command in commands {
+            // Commands own their captures and are consumed, so nothing observes their state after a panic.
+            let ran = crate::private::handle_panic(
+                || "command run by CommandBuffer::flush()",
+                AssertUnwindSafe(command),
+            );
+
+            match ran {
+                Some(true) => stats.executed += 1,
+                Some(false) => stats.skipped += 1,
+                None => stats.panicked += 1,
+            }
+        }
+
+        stats
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, Vec<Command>> {
+        // A panicking command cannot leave the vector in an inconsistent state, so poisoning can be ignored.
+        self.commands
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+}
+
+impl Default for CommandBuffer {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Result of [`CommandBuffer::flush()`].
+#[derive(Copy, Clone, Eq, PartialEq, Debug, Default)]
+pub struct FlushStats {
+    /// Commands that ran.
+    pub executed: usize,
+
+    /// Commands whose object was freed in the meantime, or did not have the expected class.
+    pub skipped: usize,
+
+    /// Commands that panicked; the panic has been printed to Godot.
+    pub panicked: usize,
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Signal future
+
+const RECEIVER_CLASS_NAME: &str = "GdextSignalReceiver";
+const RECEIVE_METHOD_NAME: &str = "receive";
+
+/// Whether the receiver class is registered with Godot.
+///
+/// Registered on first use rather than during library initialization: every gdext library would otherwise register
+/// a class of the same name, and all but the first would fail to load.
+static RECEIVER_REGISTERED: AtomicBool = AtomicBool::new(false);
+
+/// Future that completes with the arguments of the next emission of a Godot signal.
+///
+/// This is the equivalent of GDScript's `await object.signal`. An executor is needed to `.await` it; alternatively,
+/// [`try_take()`][Self::try_take] checks for completion without one. Like `Gd`, it can only be used on the main thread.
+///
+/// ```no_run
+/// # use godot::prelude::*;
+/// use godot::deferred::SignalFuture;
+///
+/// async fn wait_for_timeout(timer: Gd<Timer>) {
+///     let args = SignalFuture::new(&timer, "timeout").await;
+///     assert!(args.is_empty());
+/// }
+/// ```
+#[must_use = "futures do nothing unless polled"]
+pub struct SignalFuture {
+    receiver: Gd<SignalReceiver>,
+}
+
+impl SignalFuture {
+    /// Connects to `signal` of `source`. Only emissions after this call are observed.
+    pub fn new<T, S>(source: &Gd<T>, signal: S) -> Self
+    where
+        T: Inherits<Object>,
+        S: Into<StringName>,
+    {
+        SignalReceiver::ensure_registered();
+
+        let receiver = Gd::<SignalReceiver>::new_default();
+        let callable = Callable::from_object_method(receiver.share(), RECEIVE_METHOD_NAME);
+
+        // Disconnect after the first emission.
+        let flags = object::ConnectFlags::CONNECT_ONE_SHOT.ord() as i64;
+
+        let mut source = source.share().upcast::<Object>();
+        source.connect(signal.into(), callable, flags);
+
+        Self { receiver }
+    }
+
+    /// Returns the signal arguments if the signal has been emitted, without registering a waker.
+    ///
+    /// Returns `Some` only once; afterwards, the future counts as pending again.
+    pub fn try_take(&mut self) -> Option<Vec<Variant>> {
+        self.receiver.bind_mut().args.take()
+    }
+}
+
+impl Future for SignalFuture {
+    type Output = Vec<Variant>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        let mut receiver = self.get_mut().receiver.bind_mut();
+
+        match receiver.args.take() {
+            Some(args) => Poll::Ready(args),
+            None => {
+                receiver.waker = Some(cx.waker().clone());
+                Poll::Pending
+            }
+        }
+    }
+}
+
+/// Connection target of a [`SignalFuture`]. Reference-counted, so it lives exactly as long as the future.
+pub(crate) struct SignalReceiver {
+    #[allow(dead_code)]
+    base: Base<RefCounted>,
+    args: Option<Vec<Variant>>,
+    waker: Option<Waker>,
+}
+
+impl SignalReceiver {
+    fn ensure_registered() {
+        // SignalFuture is main-thread only, like Gd; the atomic just avoids a `static mut`.
+        if RECEIVER_REGISTERED.swap(true, Ordering::Relaxed) {
+            return;
+        }
+
+        let components = [
+            crate::private::PluginComponent::ClassDef {
+                base_class_name: <RefCounted as GodotClass>::CLASS_NAME,
+                generated_create_fn: Some(crate::private::callbacks::create::<SignalReceiver>),
+                free_fn: crate::private::callbacks::free::<SignalReceiver>,
+                lazy_methods: false,
+            },
+            crate::private::PluginComponent::UserMethodBinds {
+                generated_register_fn: crate::private::ErasedRegisterFn {
+                    raw: crate::private::callbacks::register_user_binds::<SignalReceiver>,
+                },
+            },
+        ];
+
+        crate::registry::register_class_components(RECEIVER_CLASS_NAME, components);
+    }
+
+    fn register_receive() {
+        // Registered by hand rather than with gdext_register_method!, since the method must accept any number of
+        // arguments (vararg), depending on the connected signal.
+        let class_name = StringName::from(RECEIVER_CLASS_NAME);
+        let method_name = StringName::from(RECEIVE_METHOD_NAME);
+
+        let method_info = sys::GDExtensionClassMethodInfo {
+            name: method_name.string_sys(),
+            method_userdata: std::ptr::null_mut(),
+            call_func: Some(receive_varcall),
+            ptrcall_func: None,
+            method_flags: (sys::GDEXTENSION_METHOD_FLAGS_DEFAULT
+                | sys::GDEXTENSION_METHOD_FLAG_VARARG) as u32,
+            has_return_value: false as u8,
+            return_value_info: std::ptr::null_mut(),
+            return_value_metadata: sys::GDEXTENSION_METHOD_ARGUMENT_METADATA_NONE,
+            argument_count: 0,
+            arguments_info: std::ptr::null_mut(),
+            arguments_metadata: std::ptr::null_mut(),
+            default_argument_count: 0,
+            default_arguments: std::ptr::null_mut(),
+        };
+
+        unsafe {
+            interface_fn!(classdb_register_extension_class_method)(
+                sys::get_library(),
+                class_name.string_sys(),
+                std::ptr::addr_of!(method_info),
+            );
+        }
+    }
+}
+
+unsafe extern "C" fn receive_varcall(
+    _method_data: *mut std::ffi::c_void,
+    instance_ptr: sys::GDExtensionClassInstancePtr,
+    args: *const sys::GDExtensionConstVariantPtr,
+    arg_count: sys::GDExtensionInt,
+    ret: sys::GDExtensionVariantPtr,
+    err: *mut sys::GDExtensionCallError,
+) {
+    let success = crate::private::handle_panic(
+        || RECEIVE_METHOD_NAME,
+        || {
+            let args: Vec<Variant> = (0..arg_count as usize)
+                .map(|i| Variant::borrow_var_sys(*args.add(i)).clone())
+                .collect();
+
+            // Release the borrow before waking, in case the executor polls right away.
+            let waker = {
+                let storage = crate::private::as_storage::<SignalReceiver>(instance_ptr);
+                let mut receiver = storage.get_mut();
+                receiver.args = Some(args);
+                receiver.waker.take()
+            };
+
+            if let Some(waker) = waker {
+                waker.wake();
+            }
+        },
+    );
+
+    if success.is_none() {
+        (*err).error = sys::GDEXTENSION_CALL_ERROR_INVALID_METHOD;
+    }
+    interface_fn!(variant_new_nil)(ret);
+}
+
+impl GodotClass for SignalReceiver {
+    type Base = RefCounted;
+    type Declarer = dom::UserDomain;
+    type Mem = <RefCounted as GodotClass>::Mem;
+
+    const CLASS_NAME: &'static str = RECEIVER_CLASS_NAME;
+}
+
+impl cap::GodotInit for SignalReceiver {
+    fn __godot_init(base: Base<Self::Base>) -> Self {
+        Self {
+            base,
+            args: None,
+            waker: None,
+        }
+    }
+}
+
+impl cap::ImplementsGodotExports for SignalReceiver {
+    fn __register_exports() {}
+}
+
+impl cap::ImplementsGodotApi for SignalReceiver {
+    fn __register_methods() {
+        Self::register_receive();
+    }
+}
+
+crate::private::class_macros::inherits_transitive_RefCounted!(SignalReceiver);
@@ -16,6 +16,8 @@ pub unsafe fn __gdext_load_library<E: ExtensionLibrary>(
 ) -> sys::GDExtensionBool {
     let init_code = || {
         sys::initialize(interface, library);
+        crate::builtin::Variant::initialize_fast_path();
+        crate::deferred::initialize();
 
         let mut handle = InitHandle::new();
 
@@ -76,7 +78,14 @@ unsafe extern "C" fn ffi_deinitialize_layer(
 
     crate::private::handle_panic(ctx, || {
         let handle = INIT_HANDLE.as_mut().unwrap();
-        handle.run_deinit_function(InitLevel::from_sys(init_level));
+        let level = InitLevel::from_sys(init_level);
+        handle.run_deinit_function(level);
+
+        // Classes are unregistered along with the library; don't leave their lazy methods behind for a re-init.
+        if level == handle.lowest_init_level() {
+            crate::registry::clear_lazy_methods();
+            crate::deferred::deinitialize();
+        }
     });
 }
 
@@ -135,11 +144,16 @@ struct DefaultLayer;
 impl ExtensionLayer for DefaultLayer {
     fn initialize(&mut self) {
         crate::auto_register_classes();
+
+        #[cfg(feature = "instrument")]
+        crate::instrument::register_singleton();
     }
 
     fn deinitialize(&mut self) {
-        // Nothing -- note that any cleanup task should be performed outside of this method,
+        // Nothing else -- note that any cleanup task should be performed outside of this method,
         // as the user is free to use a different impl, so cleanup code may not be run.
+        #[cfg(feature = "instrument")]
+        crate::instrument::unregister_singleton();
     }
 }
 
@@ -0,0 +1,621 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Counters and latency histograms for FFI hot paths, enabled with the `instrument` feature.
+//!
+//! Without the feature, this module does not exist and the instrumentation points compile to nothing.
+//!
+//! Every event is counted per [`Category`]. Calls of registered methods (ptrcall and varcall) are additionally
+//! counted and timed per method. [`snapshot()`] returns the current values; they are also available in GDScript
+//! through the `FfiStats` singleton:
+//!
+//! ```gdscript
+//! var stats: Dictionary = FfiStats.snapshot()
+//! FfiStats.reset()
+//! ```
+//!
+//! The singleton is registered by the default extension layer. Libraries with a custom Scene-level layer can call
+//! [`register_singleton()`] and [`unregister_singleton()`] themselves.
+
+use crate::builtin::{Dictionary, GodotString, StringName, ToVariant, VariantArray};
+use crate::engine::{Engine, Object};
+use crate::obj::{cap, dom, Base, Gd, GodotClass, InstanceId, Share};
+
+use std::ptr;
+use std::sync::atomic::{AtomicBool, AtomicPtr, AtomicU64, Ordering};
+use std::sync::Mutex;
+use std::time::{Duration, Instant};
+
+/// Number of latency buckets. Bucket `i` holds durations in `[2^i, 2^(i+1))` nanoseconds; the last is open-ended.
+pub const LATENCY_BUCKETS: usize = 32;
+
+/// Kind of instrumented event.
+#[derive(Copy, Clone, Eq, PartialEq, Hash, Debug)]
+pub enum Category {
+    /// Godot calls a registered Rust method through ptrcall.
+    Ptrcall,
+
+    /// Godot calls a registered Rust method through varcall.
+    Varcall,
+
+    /// Godot calls an overridden virtual method (e.g. `_ready`).
+    VirtualCall,
+
+    /// Godot looks up a virtual method of a Rust class.
+    GetVirtual,
+
+    /// Godot sets or gets an exported property through the class's `set_func`/`get_func`.
+    PropertyAccess,
+
+    /// `Gd::bind()`
+    Bind,
+
+    /// `Gd::bind_mut()`
+    BindMut,
+
+    /// Godot increments the reference count of a Rust instance.
+    RefInc,
+
+    /// Godot decrements the reference count of a Rust instance.
+    RefDec,
+}
+
+impl Category {
+    pub const ALL: [Category; 9] = [
+        Self::Ptrcall,
+        Self::Varcall,
+        Self::VirtualCall,
+        Self::GetVirtual,
+        Self::PropertyAccess,
+        Self::Bind,
+        Self::BindMut,
+        Self::RefInc,
+        Self::RefDec,
+    ];
+
+    pub fn name(self) -> &'static str {
+        match self {
+            Self::Ptrcall => "ptrcall",
+            Self::Varcall => "varcall",
+            Self::VirtualCall => "virtual_call",
+            Self::GetVirtual => "get_virtual",
+            Self::PropertyAccess => "property_access",
+            Self::Bind => "bind",
+            Self::BindMut => "bind_mut",
+            Self::RefInc => "ref_inc",
+            Self::RefDec => "ref_dec",
+        }
+    }
+
+    fn counters(self) -> &'static Counters {
+        &CATEGORIES[self as usize]
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Recording
+
+struct Counters {
+    count: AtomicU64,
+    total_ns: AtomicU64,
+    buckets: [AtomicU64; LATENCY_BUCKETS],
+}
+
+impl Counters {
+    #[allow(clippy::declare_interior_mutable_const)] // Only used as array initializer.
+    const NEW: Self = Self::new();
+
+    const fn new() -> Self {
+        #[allow(clippy::declare_interior_mutable_const)]
+        const ZERO: AtomicU64 = AtomicU64::new(0);
+
+        Self {
+            count: ZERO,
+            total_ns: ZERO,
+            buckets: [ZERO; LATENCY_BUCKETS],
+        }
+    }
+
+    #[inline]
+    fn count(&self) {
+        self.count.fetch_add(1, Ordering::Relaxed);
+    }
+
+    fn record(&self, elapsed: Duration) {
+        let nanos = u64::try_from(elapsed.as_nanos()).unwrap_or(u64::MAX);
+        self.count();
+        self.total_ns.fetch_add(nanos, Ordering::Relaxed);
+        self.buckets[bucket_index(nanos)].fetch_add(1, Ordering::Relaxed);
+    }
+
+    fn reset(&self) {
+        self.count.store(0, Ordering::Relaxed);
+        self.total_ns.store(0, Ordering::Relaxed);
+        for bucket in self.buckets.iter() {
+            bucket.store(0, Ordering::Relaxed);
+        }
+    }
+
+    fn latency(&self) -> Latency {
+        let mut buckets = [0; LATENCY_BUCKETS];
+        for (dst, src) in buckets.iter_mut().zip(self.buckets.iter()) {
+            *dst = src.load(Ordering::Relaxed);
+        }
+
+        Latency {
+            total: Duration::from_nanos(self.total_ns.load(Ordering::Relaxed)),
+            buckets,
+        }
+    }
+}
+
+static CATEGORIES: [Counters; Category::ALL.len()] = [Counters::NEW; Category::ALL.len()];
+
+/// Intrusive list of all call sites that recorded at least once.
+static CALL_SITES: AtomicPtr<CallSite> = AtomicPtr::new(ptr::null_mut());
+
+fn bucket_index(nanos: u64) -> usize {
+    let log2 = (u64::BITS - 1).saturating_sub(nanos.leading_zeros()) as usize;
+    log2.min(LATENCY_BUCKETS - 1)
+}
+
+/// Counts an event without timing it.
+#[doc(hidden)]
+#[inline]
+pub fn count(category: Category) {
+    category.counters().count();
+}
+
+/// Starts timing an event that is not attributed to a method. Recorded when the returned guard is dropped.
+#[doc(hidden)]
+#[inline]
+pub fn time(category: Category) -> Timer {
+    Timer {
+        category,
+        site: None,
+        start: Instant::now(),
+    }
+}
+
+/// Static state of one instrumented method; created by the registration macros.
+#[doc(hidden)]
+pub struct CallSite {
+    category: Category,
+    name: &'static str,
+    counters: Counters,
+    registered: AtomicBool,
+    next: AtomicPtr<CallSite>,
+}
+
+impl CallSite {
+    pub const fn new(category: Category, name: &'static str) -> Self {
+        Self {
+            category,
+            name,
+            counters: Counters::new(),
+            registered: AtomicBool::new(false),
+            next: AtomicPtr::new(ptr::null_mut()),
+        }
+    }
+
+    /// Starts timing a call. Recorded when the returned guard is dropped.
+    #[inline]
+    pub fn start(&'static self) -> Timer {
+        Timer {
+            category: self.category,
+            site: Some(self),
+            start: Instant::now(),
+        }
+    }
+
+    fn record(&'static self, elapsed: Duration) {
+        if !self.registered.swap(true, Ordering::Relaxed) {
+            self.link();
+        }
+
+        self.counters.record(elapsed);
+    }
+
+    fn link(&'static self) {
+        let this = self as *const Self as *mut Self;
+        let mut head = CALL_SITES.load(Ordering::Acquire);
+        loop {
+            self.next.store(head, Ordering::Relaxed);
+            match CALL_SITES.compare_exchange_weak(head, this, Ordering::AcqRel, Ordering::Acquire)
+            {
+                Ok(_) => break,
+                Err(current) => head = current,
+            }
+        }
+    }
+}
+
+/// Records the elapsed time since its creation when dropped, also on panic.
+#[doc(hidden)]
+pub struct Timer {
+    category: Category,
+    site: Option<&'static CallSite>,
+    start: Instant,
+}
+
+impl Drop for Timer {
+    fn drop(&mut self) {
+        let elapsed = self.start.elapsed();
+        self.category.counters().record(elapsed);
+
+        if let Some(site) = self.site {
+            site.record(elapsed);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Snapshots
+
+/// Latency distribution of timed events.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct Latency {
+    /// Sum of all recorded durations.
+    pub total: Duration,
+
+    /// Number of events per power-of-two bucket, see [`LATENCY_BUCKETS`].
+    pub buckets: [u64; LATENCY_BUCKETS],
+}
+
+impl Latency {
+    pub fn samples(&self) -> u64 {
+        self.buckets.iter().sum()
+    }
+
+    pub fn mean(&self) -> Option<Duration> {
+        match self.samples() {
+            0 => None,
+            samples => {
+                let total_ns = u64::try_from(self.total.as_nanos()).unwrap_or(u64::MAX);
+                Some(Duration::from_nanos(total_ns / samples))
+            }
+        }
+    }
+
+    /// Upper bound of the bucket containing the `quantile` (between 0.0 and 1.0), e.g. `0.99` for p99.
+    pub fn percentile_upper_bound(&self, quantile: f64) -> Option<Duration> {
+        let samples = self.samples();
+        if samples == 0 {
+            return None;
+        }
+
+        let rank = ((samples as f64 * quantile.clamp(0.0, 1.0)).ceil() as u64).max(1);
+        let mut seen = 0;
+        for (index, count) in self.buckets.iter().enumerate() {
+            seen += count;
+            if seen >= rank {
+                return Some(Duration::from_nanos(
+                    1u64.checked_shl(index as u32 + 1).unwrap_or(u64::MAX),
+                ));
+            }
+        }
+
+        None
+    }
+}
+
+#[derive(Clone, Debug)]
+pub struct CategoryStats {
+    pub category: Category,
+    pub count: u64,
+
+    /// Only contains samples for timed events; count-only categories (e.g. [`Category::Bind`]) have empty buckets.
+    pub latency: Latency,
+}
+
+#[derive(Clone, Debug)]
+pub struct MethodStats {
+    pub category: Category,
+
+    /// `Class::method`
+    pub name: &'static str,
+    pub count: u64,
+    pub latency: Latency,
+}
+
+/// Values of all counters at one point in time.
+#[derive(Clone, Debug)]
+pub struct Snapshot {
+    /// One entry per category, in the order of [`Category::ALL`].
+    pub categories: Vec<CategoryStats>,
+
+    /// Methods called at least once, sorted by descending total time.
+    pub methods: Vec<MethodStats>,
+}
+
+impl Snapshot {
+    pub fn category(&self, category: Category) -> &CategoryStats {
+        &self.categories[category as usize]
+    }
+
+    pub fn method(&self, category: Category, name: &str) -> Option<&MethodStats> {
+        self.methods
+            .iter()
+            .find(|method| method.category == category && method.name == name)
+    }
+
+    /// Converts to the format returned by `FfiStats.snapshot()` in GDScript.
+    ///
+    /// `{ "categories": { "ptrcall": { "count", "total_ns", "buckets" }, ... }, "methods": [ { "name", "category",
+    /// "count", "total_ns", "buckets" }, ... ] }`
+    pub fn to_dictionary(&self) -> Dictionary {
+        let mut categories = Dictionary::new();
+        for stats in self.categories.iter() {
+            let entry = latency_dictionary(stats.count, &stats.latency);
+            categories.insert(GodotString::from(stats.category.name()), entry);
+        }
+
+        let mut methods = VariantArray::new();
+        for stats in self.methods.iter() {
+            let mut entry = latency_dictionary(stats.count, &stats.latency);
+            entry.insert(GodotString::from("name"), GodotString::from(stats.name));
+            entry.insert(
+                GodotString::from("category"),
+                GodotString::from(stats.category.name()),
+            );
+            methods.push(entry.to_variant());
+        }
+
+        let mut result = Dictionary::new();
+        result.insert(GodotString::from("categories"), categories);
+        result.insert(GodotString::from("methods"), methods);
+        result
+    }
+}
+
+fn latency_dictionary(count: u64, latency: &Latency) -> Dictionary {
+    let mut buckets = VariantArray::new();
+    for bucket in latency.buckets.iter() {
+        buckets.push(saturating_i64(*bucket).to_variant());
+    }
+
+    let total_ns = u64::try_from(latency.total.as_nanos()).unwrap_or(u64::MAX);
+
+    let mut result = Dictionary::new();
+    result.insert(GodotString::from("count"), saturating_i64(count));
+    result.insert(GodotString::from("total_ns"), saturating_i64(total_ns));
+    result.insert(GodotString::from("buckets"), buckets);
+    result
+}
+
+fn saturating_i64(value: u64) -> i64 {
+    i64::try_from(value).unwrap_or(i64::MAX)
+}
+
+/// Reads all counters. Counters are updated concurrently, so values may be slightly inconsistent with each other.
+pub fn snapshot() -> Snapshot {
+    let categories = Category::ALL
+        .iter()
+        .map(|&category| {
+            let counters = category.counters();
+            CategoryStats {
+                category,
+                count: counters.count.load(Ordering::Relaxed),
+                latency: counters.latency(),
+            }
+        })
+        .collect();
+
+    let mut methods = vec![];
+    for_each_call_site(|site| {
+        let count = site.counters.count.load(Ordering::Relaxed);
+        if count > 0 {
+            methods.push(MethodStats {
+                category: site.category,
+                name: site.name,
+                count,
+                latency: site.counters.latency(),
+            });
+        }
+    });
+    methods.sort_by(|a, b| b.latency.total.cmp(&a.latency.total));
+
+    Snapshot {
+        categories,
+        methods,
+    }
+}
+
+/// Sets all counters to zero.
+pub fn reset() {
+    for category in Category::ALL {
+        category.counters().reset();
+    }
+
+    for_each_call_site(|site| site.counters.reset());
+}
+
+fn for_each_call_site(mut visitor: impl FnMut(&'static CallSite)) {
+    let mut current = CALL_SITES.load(Ordering::Acquire);
+
+    // SAFETY: the list only contains `&'static CallSite`; nodes are never removed.
+    while let Some(site) = unsafe { current.as_ref() } {
+        visitor(site);
+        current = site.next.load(Ordering::Acquire);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Godot singleton
+
+const SINGLETON_NAME: &str = "FfiStats";
+
+/// Engine-side view of the counters: `FfiStats.snapshot()` and `FfiStats.reset()`.
+pub struct FfiStats {
+    #[allow(dead_code)]
+    base: Base<Object>,
+}
+
+impl FfiStats {
+    fn snapshot(&self) -> Dictionary {
+        snapshot().to_dictionary()
+    }
+
+    fn reset(&self) {
+        reset()
+    }
+}
+
+impl GodotClass for FfiStats {
+    type Base = Object;
+    type Declarer = dom::UserDomain;
+    type Mem = <Object as GodotClass>::Mem;
+
+    const CLASS_NAME: &'static str = SINGLETON_NAME;
+}
+
+impl cap::GodotInit for FfiStats {
+    fn __godot_init(base: Base<Self::Base>) -> Self {
+        Self { base }
+    }
+}
+
+impl cap::ImplementsGodotExports for FfiStats {
+    fn __register_exports() {}
+}
+
+impl cap::ImplementsGodotApi for FfiStats {
+    fn __register_methods() {
+        crate::gdext_register_method!(FfiStats, fn snapshot(&self) -> Dictionary);
+        crate::gdext_register_method!(FfiStats, fn reset(&self));
+    }
+}
+
+crate::sys::plugin_add!(__GODOT_PLUGIN_REGISTRY in crate::private; crate::private::ClassPlugin {
+    class_name: SINGLETON_NAME,
+    component: crate::private::PluginComponent::ClassDef {
+        base_class_name: <Object as GodotClass>::CLASS_NAME,
+        generated_create_fn: Some(crate::private::callbacks::create::<FfiStats>),
+        free_fn: crate::private::callbacks::free::<FfiStats>,
+        lazy_methods: false,
+    },
+});
+
+crate::sys::plugin_add!(__GODOT_PLUGIN_REGISTRY in crate::private; crate::private::ClassPlugin {
+    class_name: SINGLETON_NAME,
+    component: crate::private::PluginComponent::UserMethodBinds {
+        generated_register_fn: crate::private::ErasedRegisterFn {
+            raw: crate::private::callbacks::register_user_binds::<FfiStats>,
+        },
+    },
+});
+
+crate::private::class_macros::inherits_transitive_Object!(FfiStats);
+
+/// Instance of the registered `FfiStats` singleton.
+///
+/// Stores the ID rather than `Gd`, which is not `Send`. A mutex instead of a `OnceCell`, since the singleton is
+/// replaced when the library is re-initialized.
+static SINGLETON: Mutex<Option<InstanceId>> = Mutex::new(None);
+
+/// Registers the `FfiStats` engine singleton. Requires that classes are registered (Scene init level).
+pub fn register_singleton() {
+    let stats = Gd::<FfiStats>::new_default();
+    Engine::singleton()
+        .register_singleton(StringName::from(SINGLETON_NAME), stats.share().upcast());
+
+    let previous = lock_singleton().replace(stats.instance_id());
+    if let Some(previous) = previous.and_then(Gd::<FfiStats>::try_from_instance_id) {
+        previous.free();
+    }
+}
+
+/// Unregisters and frees the `FfiStats` singleton, if registered.
+pub fn unregister_singleton() {
+    let stats = lock_singleton().take();
+    if let Some(stats) = stats {
+        Engine::singleton().unregister_singleton(StringName::from(SINGLETON_NAME));
+
+        if let Some(stats) = Gd::<FfiStats>::try_from_instance_id(stats) {
+            stats.free();
+        }
+    }
+}
+
+fn lock_singleton() -> std::sync::MutexGuard<'static, Option<InstanceId>> {
+    // Only holds a plain ID, which a panic cannot leave half-written, so poisoning can be ignored.
+    SINGLETON
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn bucket_boundaries() {
+        assert_eq!(bucket_index(0), 0);
+        assert_eq!(bucket_index(1), 0);
+        assert_eq!(bucket_index(2), 1);
+        assert_eq!(bucket_index(3), 1);
+        assert_eq!(bucket_index(1024), 10);
+        assert_eq!(bucket_index(u64::MAX), LATENCY_BUCKETS - 1);
+    }
+
+    #[test]
+    fn latency_percentiles() {
+        let mut buckets = [0; LATENCY_BUCKETS];
+        buckets[3] = 90; // [8, 16) ns
+        buckets[10] = 10; // [1024, 2048) ns
+
+        let latency = Latency {
+            total: Duration::from_nanos(90 * 10 + 10 * 1500),
+            buckets,
+        };
+
+        assert_eq!(latency.samples(), 100);
+        assert_eq!(latency.mean(), Some(Duration::from_nanos(159)));
+        assert_eq!(
+            latency.percentile_upper_bound(0.5),
+            Some(Duration::from_nanos(16))
+        );
+        assert_eq!(
+            latency.percentile_upper_bound(0.99),
+            Some(Duration::from_nanos(2048))
+        );
+
+        let empty = Latency {
+            total: Duration::ZERO,
+            buckets: [0; LATENCY_BUCKETS],
+        };
+        assert_eq!(empty.mean(), None);
+        assert_eq!(empty.percentile_upper_bound(0.5), None);
+    }
+
+    #[test]
+    fn call_sites_are_listed_once() {
+        static SITE: CallSite = CallSite::new(Category::Varcall, "Test::instrumented");
+
+        for _ in 0..3 {
+            let _timer = SITE.start();
+        }
+        count(Category::Bind);
+
+        let snapshot = snapshot();
+        let method = snapshot
+            .method(Category::Varcall, "Test::instrumented")
+            .expect("call site recorded");
+        assert_eq!(method.count, 3);
+        assert_eq!(method.latency.samples(), 3);
+        assert!(snapshot.category(Category::Varcall).count >= 3);
+        assert!(snapshot.category(Category::Bind).count >= 1);
+
+        let listed = snapshot
+            .methods
+            .iter()
+            .filter(|method| method.name == "Test::instrumented")
+            .count();
+        assert_eq!(listed, 1);
+    }
+}
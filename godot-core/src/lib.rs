@@ -5,18 +5,27 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+mod property_table;
 mod registry;
 mod storage;
 
+pub mod arena;
 pub mod bind;
 pub mod builder;
 pub mod builtin;
+pub mod dataset;
+pub mod deferred;
 pub mod init;
+#[cfg(feature = "instrument")]
+pub mod instrument;
 pub mod log;
 pub mod macros;
 pub mod obj;
 
 pub use godot_ffi as sys;
+
+#[cfg(feature = "rayon")]
+pub use rayon;
 pub use registry::*;
 
 pub mod engine;
@@ -35,6 +44,7 @@ pub mod private {
     pub trait You_forgot_the_attribute__godot_api {}
 
     pub use crate::gen::classes::class_macros;
+    pub use crate::property_table::{PropertyAccessor, PropertyTable};
     pub use crate::registry::{callbacks, ClassPlugin, ErasedRegisterFn, PluginComponent};
     pub use crate::storage::as_storage;
     pub use crate::{
@@ -87,6 +97,39 @@ macro_rules! out {
     ($fmt:literal, $($arg:tt)*) => (eprintln!($fmt, $($arg)*));
 }
 
+/// Instrumentation point for the `instrument` feature; expands to nothing without it.
+///
+/// * `count Category` counts an event.
+/// * `time Category` times the rest of the enclosing block.
+/// * `time Category, "Class::method"` additionally records per method.
+#[cfg(feature = "instrument")]
+#[doc(hidden)]
+#[macro_export]
+macro_rules! gdext_instrument {
+    (count $category:ident) => {
+        $crate::instrument::count($crate::instrument::Category::$category)
+    };
+    (time $category:ident) => {
+        let _instrument_timer = $crate::instrument::time($crate::instrument::Category::$category);
+    };
+    (time $category:ident, $name:expr) => {
+        let _instrument_timer = {
+            static SITE: $crate::instrument::CallSite =
+                $crate::instrument::CallSite::new($crate::instrument::Category::$category, $name);
+            SITE.start()
+        };
+    };
+}
+
+#[cfg(not(feature = "instrument"))]
+#[doc(hidden)]
+#[macro_export]
+macro_rules! gdext_instrument {
+    (count $category:ident) => {};
+    (time $category:ident) => {};
+    (time $category:ident, $name:expr) => {};
+}
+
 #[cfg(not(feature = "trace"))]
 // TODO find a better way than sink-writing to avoid warnings, #[allow(unused_variables)] doesn't work
 #[macro_export]
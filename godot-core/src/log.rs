@@ -4,20 +4,32 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+//! Printing and logging functionality.
+//!
+//! Each invocation of the logging macros has a static call site, which holds the file, line and (lazily computed)
+//! function name passed to Godot. Before any formatting happens, a call site checks the global level filter (see
+//! [`set_max_level()`]) and, if enabled, its rate limit (see [`set_rate_limit()`]). Messages are formatted into a
+//! thread-local buffer, so logging does not allocate on the Rust side in the steady state. Godot still copies each
+//! message into its own string.
+
+use crate::builtin::{GodotString, Variant};
+use crate::sys::{self, GodotFfi};
+
+use std::cell::RefCell;
+use std::ffi::CString;
+use std::fmt;
+use std::io::Write;
+use std::os::raw::c_char;
+use std::ptr;
+use std::sync::atomic::{AtomicPtr, AtomicU32, AtomicU64, AtomicU8, Ordering};
+use std::time::Instant;
+
+use once_cell::sync::Lazy;
+
 #[macro_export]
 macro_rules! godot_warn {
     ($fmt:literal $(, $args:expr)* $(,)?) => {
-        unsafe {
-            let msg = format!("{}\0", format_args!($fmt $(, $args)*));
-
-            $crate::sys::interface_fn!(print_warning)(
-                msg.as_bytes().as_ptr() as *const _,
-                "<function unset>\0".as_bytes().as_ptr() as *const _,
-                concat!(file!(), "\0").as_ptr() as *const _,
-                line!() as _,
-                false as $crate::sys::GDExtensionBool, // whether to create a toast notification in editor
-            );
-        }
+        $crate::gdext_log!(print_warning, $crate::log::LogLevel::Warn, $fmt $(, $args)*)
     };
 }
 
@@ -26,73 +38,381 @@ macro_rules! godot_error {
     // FIXME expr needs to be parenthesised, see usages
     ($fmt:literal $(, $args:expr)* $(,)?) => {
     //($($args:tt),* $(,)?) => {
-        unsafe {
-            let msg = format!("{}\0", format_args!($fmt $(, $args)*));
-
-            $crate::sys::interface_fn!(print_error)(
-                msg.as_bytes().as_ptr() as *const _,
-                "<function unset>\0".as_bytes().as_ptr() as *const _,
-                concat!(file!(), "\0").as_ptr() as *const _,
-                line!() as _,
-                false as $crate::sys::GDExtensionBool, // whether to create a toast notification in editor
-            );
-        }
+        $crate::gdext_log!(print_error, $crate::log::LogLevel::Error, $fmt $(, $args)*)
     };
 }
 
 #[macro_export]
 macro_rules! godot_script_error {
     ($fmt:literal $(, $args:expr)* $(,)?) => {
-        unsafe {
-            let msg = format!("{}\0", format_args!($fmt $(, $args)*));
-
-            $crate::sys::interface_fn!(print_script_error)(
-                msg.as_bytes().as_ptr() as *const _,
-                "<function unset>\0".as_bytes().as_ptr() as *const _,
-                concat!(file!(), "\0").as_ptr() as *const _,
-                line!() as _,
-                false as $crate::sys::GDExtensionBool, // whether to create a toast notification in editor
-            );
-        }
+        $crate::gdext_log!(print_script_error, $crate::log::LogLevel::Error, $fmt $(, $args)*)
     };
 }
 
 #[macro_export]
 macro_rules! godot_print {
-    ($fmt:literal $(, $args:expr)* $(,)?) => {
-        $crate::log::print(&[
-            $crate::builtin::Variant::from(
-                $crate::builtin::GodotString::from(
-                    format!($fmt $(, $args)*)
-                )
-            )
-        ])
-    };
+    ($fmt:literal $(, $args:expr)* $(,)?) => {{
+        static __SITE: $crate::log::LogSite =
+            $crate::log::LogSite::new($crate::log::LogLevel::Print, concat!(file!(), "\0"), line!());
+
+        if let Some(suppressed) = __SITE.admit() {
+            $crate::log::print_fmt(format_args!($fmt $(, $args)*), suppressed);
+        }
+    }};
+}
+
+/// Shared implementation of the error/warning macros; `$print_fn` is the GDExtension interface function.
+#[doc(hidden)]
+#[macro_export]
+macro_rules! gdext_log {
+    ($print_fn:ident, $level:expr, $fmt:literal $(, $args:expr)*) => {{
+        static __SITE: $crate::log::LogSite =
+            $crate::log::LogSite::new($level, concat!(file!(), "\0"), line!());
+
+        // Only used for its type name, which contains the path of the enclosing function.
+        fn __site_fn() {}
+
+        if let Some(suppressed) = __SITE.admit() {
+            $crate::log::with_message(format_args!($fmt $(, $args)*), suppressed, |msg| unsafe {
+                $crate::sys::interface_fn!($print_fn)(
+                    msg,
+                    __SITE.function_name(__site_fn),
+                    __SITE.file(),
+                    __SITE.line() as _,
+                    false as $crate::sys::GDExtensionBool, // whether to create a toast notification in editor
+                );
+            });
+        }
+    }};
 }
 
 pub use crate::{godot_error, godot_print, godot_script_error, godot_warn};
 
-use crate::builtin::{StringName, Variant};
-use crate::sys::{self, GodotFfi};
+/// Severity of a log message; also used as filter in [`set_max_level()`].
+#[derive(Copy, Clone, Eq, PartialEq, Ord, PartialOrd, Debug)]
+#[repr(u8)]
+pub enum LogLevel {
+    /// As a filter: disables all logging.
+    Off = 0,
+
+    /// `godot_error!`, `godot_script_error!`
+    Error = 1,
+
+    /// `godot_warn!`
+    Warn = 2,
+
+    /// `godot_print!`
+    Print = 3,
+}
+
+impl LogLevel {
+    fn from_u8(value: u8) -> Self {
+        match value {
+            0 => Self::Off,
+            1 => Self::Error,
+            2 => Self::Warn,
+            _ => Self::Print,
+        }
+    }
+}
+
+/// Default for [`set_rate_limit()`]: no limit.
+pub const DEFAULT_RATE_LIMIT: u32 = 0;
+
+const RATE_WINDOW_MS: u64 = 1000;
+
+static MAX_LEVEL: AtomicU8 = AtomicU8::new(LogLevel::Print as u8);
+static RATE_LIMIT: AtomicU32 = AtomicU32::new(DEFAULT_RATE_LIMIT);
+
+/// Only messages with level `max_level` or more severe are logged; others are discarded before being formatted.
+///
+/// The default is [`LogLevel::Print`], which logs everything.
+pub fn set_max_level(max_level: LogLevel) {
+    MAX_LEVEL.store(max_level as u8, Ordering::Relaxed);
+}
+
+pub fn max_level() -> LogLevel {
+    LogLevel::from_u8(MAX_LEVEL.load(Ordering::Relaxed))
+}
+
+/// Limits how many messages a single macro invocation may log per second; `0` disables the limit.
+///
+/// Excess messages are discarded before being formatted. The next message logged from the same call site mentions
+/// how many were suppressed. The limit applies to all macros, including `godot_print!` and the error reports of
+/// panics caught at the FFI boundary.
+///
+/// The default is [`DEFAULT_RATE_LIMIT`], which logs every message. Enable a limit if some code path (e.g. a
+/// failing `_process()`) would otherwise flood the output.
+pub fn set_rate_limit(messages_per_second: u32) {
+    RATE_LIMIT.store(messages_per_second, Ordering::Relaxed);
+}
+
+pub fn rate_limit() -> u32 {
+    RATE_LIMIT.load(Ordering::Relaxed)
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Static state of one logging macro invocation.
+#[doc(hidden)]
+pub struct LogSite {
+    level: LogLevel,
+
+    /// Nul-terminated.
+    file: &'static str,
+    line: u32,
+
+    /// Nul-terminated function name, leaked on first use. Null until then.
+    function: AtomicPtr<c_char>,
+
+    window_start_ms: AtomicU64,
+    count_in_window: AtomicU32,
+    suppressed: AtomicU32,
+}
+
+impl LogSite {
+    pub const fn new(level: LogLevel, file: &'static str, line: u32) -> Self {
+        Self {
+            level,
+            file,
+            line,
+            function: AtomicPtr::new(ptr::null_mut()),
+            window_start_ms: AtomicU64::new(0),
+            count_in_window: AtomicU32::new(0),
+            suppressed: AtomicU32::new(0),
+        }
+    }
+
+    /// Checks level and rate limit. Returns `None` if the message is to be discarded, otherwise the number of
+    /// messages suppressed since the last one.
+    #[inline]
+    pub fn admit(&self) -> Option<u32> {
+        if self.level as u8 > MAX_LEVEL.load(Ordering::Relaxed) {
+            return None;
+        }
+
+        match RATE_LIMIT.load(Ordering::Relaxed) {
+            0 => Some(0),
+            limit => self.admit_rate_limited(limit, now_ms()),
+        }
+    }
+
+    fn admit_rate_limited(&self, limit: u32, now_ms: u64) -> Option<u32> {
+        // Races between threads can let a few messages more or less through; that's fine for logging.
+        let mut suppressed = 0;
+        let start = self.window_start_ms.load(Ordering::Relaxed);
+        if now_ms.saturating_sub(start) >= RATE_WINDOW_MS
+            && self
+                .window_start_ms
+                .compare_exchange(start, now_ms, Ordering::Relaxed, Ordering::Relaxed)
+                .is_ok()
+        {
+            self.count_in_window.store(0, Ordering::Relaxed);
+            suppressed = self.suppressed.swap(0, Ordering::Relaxed);
+        }
+
+        if self.count_in_window.fetch_add(1, Ordering::Relaxed) < limit {
+            Some(suppressed)
+        } else {
+            self.suppressed.fetch_add(suppressed + 1, Ordering::Relaxed);
+            None
+        }
+    }
+
+    pub fn file(&self) -> *const c_char {
+        self.file.as_ptr() as *const c_char
+    }
+
+    pub fn line(&self) -> u32 {
+        self.line
+    }
+
+    /// Name of the function containing the call site, derived from the type name of `site_fn` (a local fn item).
+    pub fn function_name<F>(&self, site_fn: F) -> *const c_char {
+        let cached = self.function.load(Ordering::Acquire);
+        if !cached.is_null() {
+            return cached;
+        }
+
+        let _ = site_fn;
+        let name = function_path(std::any::type_name::<F>());
+        let name = CString::new(name).unwrap_or_default().into_raw();
+
+        match self.function.compare_exchange(
+            ptr::null_mut(),
+            name,
+            Ordering::AcqRel,
+            Ordering::Acquire,
+        ) {
+            Ok(_) => name,
+            Err(existing) => {
+                // Another thread was faster.
+                drop(unsafe { CString::from_raw(name) });
+                existing
+            }
+        }
+    }
+}
+
+/// Strips the local fn item and closure segments, e.g. `my_crate::Foo::bar::{{closure}}::__site_fn` -> `my_crate::Foo::bar`.
+fn function_path(type_name: &str) -> &str {
+    let mut path = type_name
+        .rsplit_once("::")
+        .map_or(type_name, |(path, _)| path);
+    while let Some(stripped) = path.strip_suffix("::{{closure}}") {
+        path = stripped;
+    }
+    path
+}
+
+/// Monotonic milliseconds since the first rate-limited message; unaffected by changes of the system clock.
+fn now_ms() -> u64 {
+    static START: Lazy<Instant> = Lazy::new(Instant::now);
+
+    START.elapsed().as_millis() as u64
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+thread_local! {
+    static MESSAGE_BUFFER: RefCell<Vec<u8>> = const { RefCell::new(Vec::new()) };
+}
+
+/// Formats `args` into a reused, nul-terminated buffer and passes a pointer to it to `f`.
+#[doc(hidden)]
+pub fn with_message(args: fmt::Arguments, suppressed: u32, f: impl FnOnce(*const c_char)) {
+    with_message_bytes(args, suppressed, |bytes| f(bytes.as_ptr() as *const c_char));
+}
+
+/// Like [`with_message()`], but passes the formatted bytes, including the nul terminator.
+fn with_message_bytes(args: fmt::Arguments, suppressed: u32, f: impl FnOnce(&[u8])) {
+    let mut f = Some(f);
+    let mut emit = |buffer: &mut Vec<u8>| {
+        buffer.clear();
+        write_message(buffer, args, suppressed);
+        buffer.push(0);
+
+        if let Some(f) = f.take() {
+            f(buffer);
+        }
+    };
+
+    // The buffer is busy if formatting logs itself (a Display impl calling godot_error!), or during thread shutdown.
+    let reused = MESSAGE_BUFFER
+        .try_with(|buffer| match buffer.try_borrow_mut() {
+            Ok(mut buffer) => {
+                emit(&mut buffer);
+                true
+            }
+            Err(_) => false,
+        })
+        .unwrap_or(false);
+
+    if !reused {
+        emit(&mut Vec::new());
+    }
+}
+
+fn write_message(buffer: &mut Vec<u8>, args: fmt::Arguments, suppressed: u32) {
+    // Writing to a Vec only fails if a Display impl returns an error; log what was written so far.
+    let _ = buffer.write_fmt(args);
+
+    if suppressed > 0 {
+        let _ = write!(buffer, " ({suppressed} similar messages suppressed)");
+    }
+}
+
+#[doc(hidden)]
+pub fn print_fmt(args: fmt::Arguments, suppressed: u32) {
+    with_message_bytes(args, suppressed, |bytes| {
+        // Formatting only writes `str`s, so the bytes are valid UTF-8 and this borrows.
+        let message = String::from_utf8_lossy(&bytes[..bytes.len() - 1]);
+        let message = Variant::from(GodotString::from(message.as_ref()));
+
+        call_print(&[message.sys_const()]);
+    });
+}
 
 pub fn print(varargs: &[Variant]) {
+    let mut args = Vec::new();
+    args.extend(varargs.iter().map(Variant::sys_const));
+
+    call_print(&args);
+
+    // TODO use generated method, but figure out how print() with zero args can be called
+    // crate::engine::utilities::print(head, rest);
+}
+
+fn call_print(args: &[sys::GDExtensionConstTypePtr]) {
     unsafe {
-        let method_name = StringName::from("print");
+        let method_name = crate::static_sname!("print");
         let call_fn = sys::interface_fn!(variant_get_ptr_utility_function)(
             method_name.string_sys(),
             2648703342i64,
         );
         let call_fn = call_fn.unwrap_unchecked();
 
-        let mut args = Vec::new();
-        args.extend(varargs.iter().map(Variant::sys_const));
-
-        let args_ptr = args.as_ptr();
         let _variant = Variant::from_sys_init_default(|return_ptr| {
-            call_fn(return_ptr, args_ptr, args.len() as i32);
+            call_fn(return_ptr, args.as_ptr(), args.len() as i32);
         });
     }
+}
 
-    // TODO use generated method, but figure out how print() with zero args can be called
-    // crate::engine::utilities::print(head, rest);
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn function_path_strips_local_items() {
+        assert_eq!(function_path("a::b::f::__site_fn"), "a::b::f");
+        assert_eq!(
+            function_path("a::T::f::{{closure}}::{{closure}}::__site_fn"),
+            "a::T::f"
+        );
+        assert_eq!(function_path("__site_fn"), "__site_fn");
+
+        fn __site_fn() {}
+        let site = LogSite::new(LogLevel::Warn, "file\0", 1);
+        let name = unsafe { std::ffi::CStr::from_ptr(site.function_name(__site_fn)) };
+        assert!(name
+            .to_str()
+            .unwrap()
+            .ends_with("tests::function_path_strips_local_items"));
+    }
+
+    #[test]
+    fn rate_limit_per_window() {
+        let site = LogSite::new(LogLevel::Warn, "file\0", 1);
+        let start = 10_000;
+
+        assert_eq!(site.admit_rate_limited(2, start), Some(0));
+        assert_eq!(site.admit_rate_limited(2, start + 1), Some(0));
+        assert_eq!(site.admit_rate_limited(2, start + 2), None);
+        assert_eq!(site.admit_rate_limited(2, start + 999), None);
+
+        // New window: reports suppressed count once.
+        assert_eq!(site.admit_rate_limited(2, start + 1000), Some(2));
+        assert_eq!(site.admit_rate_limited(2, start + 1001), Some(0));
+    }
+
+    #[test]
+    fn message_formatting() {
+        let mut buffer = vec![];
+        write_message(&mut buffer, format_args!("x={}", 5), 0);
+        assert_eq!(buffer, b"x=5");
+
+        buffer.clear();
+        write_message(&mut buffer, format_args!("y"), 3);
+        assert_eq!(buffer, b"y (3 similar messages suppressed)");
+
+        let mut seen = String::new();
+        with_message(format_args!("{}-{}", 1, 2), 0, |msg| {
+            seen = unsafe { std::ffi::CStr::from_ptr(msg) }
+                .to_string_lossy()
+                .into_owned();
+        });
+        assert_eq!(seen, "1-2");
+    }
 }
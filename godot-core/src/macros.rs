@@ -51,7 +51,7 @@ macro_rules! gdext_register_method_inner {
     ) => {
         unsafe {
             use $crate::sys;
-            use $crate::builtin::{Variant, StringName};
+            use $crate::builtin::Variant;
             use $crate::builtin::meta::*;
 
             const NUM_ARGS: usize = $crate::gdext_count_idents!($( $param, )*);
@@ -67,17 +67,20 @@ macro_rules! gdext_register_method_inner {
                     ret: sys::GDExtensionVariantPtr,
                     err: *mut sys::GDExtensionCallError,
                 ) {
+                    $crate::gdext_instrument!(time Varcall, concat!(stringify!($Class), "::", stringify!($method_name)));
+
                     let success = $crate::private::handle_panic(
                         || stringify!($method_name),
                         || {
-                            <Sig as SignatureTuple>::varcall::< $Class >(
+                            <Sig as SignatureTuple>::varcall(
                                 instance_ptr,
                                 args,
                                 ret,
                                 err,
-                                |inst, params| {
+                                |instance_ptr, params| {
                                     let ( $($param,)* ) = params;
-                                    inst.$method_name( $( $param, )* )
+                                    let storage = $crate::private::as_storage::<$Class>(instance_ptr);
+                                    storage.$map_method(|inst| inst.$method_name( $( $param, )* ))
                                 },
                                 stringify!($method_name),
                             );
@@ -101,16 +104,19 @@ macro_rules! gdext_register_method_inner {
                     args: *const sys::GDExtensionConstTypePtr,
                     ret: sys::GDExtensionTypePtr,
                 ) {
+                    $crate::gdext_instrument!(time Ptrcall, concat!(stringify!($Class), "::", stringify!($method_name)));
+
                     let success = $crate::private::handle_panic(
                         || stringify!($method_name),
                         || {
-                            <Sig as SignatureTuple>::ptrcall::< $Class >(
+                            <Sig as SignatureTuple>::ptrcall(
                                 instance_ptr,
                                 args,
                                 ret,
-                                |inst, params| {
+                                |instance_ptr, params| {
                                     let ( $($param,)* ) = params;
-                                    inst.$method_name( $( $param, )* )
+                                    let storage = $crate::private::as_storage::<$Class>(instance_ptr);
+                                    storage.$map_method(|inst| inst.$method_name( $( $param, )* ))
                                 },
                                 stringify!($method_name),
                             );
@@ -150,8 +156,8 @@ macro_rules! gdext_register_method_inner {
             let mut arguments_metadata: [sys::GDExtensionClassMethodArgumentMetadata; NUM_ARGS]
                 = std::array::from_fn(|i| Sig::param_metadata(i as i32));
 
-            let class_name = StringName::from(stringify!($Class));
-            let method_name = StringName::from(stringify!($method_name));
+            let class_name = $crate::static_sname!(stringify!($Class));
+            let method_name = $crate::static_sname!(stringify!($method_name));
 
             // println!("REG {class_name}::{method_name}");
             // println!("  ret {return_value_info:?}");
@@ -295,7 +301,7 @@ macro_rules! gdext_virtual_method_callback_inner {
             ) {
                 $crate::gdext_ptrcall!(
                     instance_ptr, args, ret;
-                    $Class;
+                    $Class, $map_method;
                     fn $method_name( $( $arg : $Param, )* ) -> $Ret
                 );
             }
@@ -390,16 +396,15 @@ macro_rules! gdext_virtual_method_callback {
 macro_rules! gdext_ptrcall {
     (
         $instance_ptr:ident, $args:ident, $ret:ident;
-        $Class:ty;
+        $Class:ty, $map_method:ident;
         fn $method_name:ident(
             $( $arg:ident : $ParamTy:ty, )*
         ) -> $( $RetTy:tt )+
     ) => {
         use $crate::sys;
 
-        $crate::out!("ptrcall: {}", stringify!($method_name));
+        $crate::gdext_instrument!(time VirtualCall, concat!(stringify!($Class), "::", stringify!($method_name)));
         let storage = $crate::private::as_storage::<$Class>($instance_ptr);
-        let mut instance = storage.get_mut();
 
         let mut idx = 0;
         $(
@@ -409,9 +414,9 @@ macro_rules! gdext_ptrcall {
             idx += 1;
         )*
 
-        let ret_val = instance.$method_name($(
+        let ret_val = storage.$map_method(|instance| instance.$method_name($(
             $arg,
-        )*);
+        )*));
 
         <$($RetTy)+ as sys::GodotFfi>::write_sys(&ret_val, $ret);
         // FIXME is inc_ref needed here?
@@ -0,0 +1,141 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use std::any::TypeId;
+use std::ffi::c_void;
+use std::ptr;
+use std::sync::atomic::{AtomicPtr, Ordering};
+
+use godot_ffi as sys;
+use sys::interface_fn;
+
+use crate::builtin::meta::ClassName;
+use crate::obj::GodotClass;
+
+/// Identifies a class registered in Godot's `ClassDB`, as used for dynamic casts (`object_cast_to`).
+///
+/// The tag is null if the class is not (yet) registered.
+#[derive(Copy, Clone, Eq, PartialEq, Hash, Debug)]
+pub struct ClassTag {
+    tag: *mut c_void,
+}
+
+// SAFETY: the tag is an opaque identifier which is never dereferenced on the Rust side.
+unsafe impl Send for ClassTag {}
+unsafe impl Sync for ClassTag {}
+
+impl ClassTag {
+    /// Asks the engine for the tag of class `T`, without caching. Prefer `T::__class_tag()`.
+    pub fn lookup<T: GodotClass>() -> Self {
+        let class_name = ClassName::of::<T>();
+        let tag = unsafe { interface_fn!(classdb_get_class_tag)(class_name.string_sys()) };
+
+        Self { tag }
+    }
+
+    pub fn is_null(self) -> bool {
+        self.tag.is_null()
+    }
+
+    pub(crate) fn as_ptr(self) -> *mut c_void {
+        self.tag
+    }
+}
+
+/// Lazily resolved class tag, intended to be stored in a `static` per class.
+///
+/// Generated `GodotClass` impls use this to implement `__class_tag()`, so that building the class name and querying
+/// `ClassDB` happens once per class instead of once per cast.
+#[doc(hidden)]
+pub struct ClassTagCache {
+    tag: AtomicPtr<c_void>,
+}
+
+impl ClassTagCache {
+    pub const fn new() -> Self {
+        Self {
+            tag: AtomicPtr::new(ptr::null_mut()),
+        }
+    }
+
+    pub fn get<T: GodotClass>(&self) -> ClassTag {
+        let tag = self.tag.load(Ordering::Relaxed);
+        if !tag.is_null() {
+            return ClassTag { tag };
+        }
+
+        // Concurrent first lookups are benign, they yield the same tag.
+        // Null (class not registered yet) is not cached, so it is looked up again next time.
+        let resolved = ClassTag::lookup::<T>();
+        self.tag.store(resolved.tag, Ordering::Relaxed);
+        resolved
+    }
+}
+
+impl Default for ClassTagCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Whether `Base` is `T` itself or one of its ancestors, according to the static `GodotClass::Base` chain.
+///
+/// This involves no FFI and no lookup at runtime: after monomorphization, the `TypeId` comparisons are constant-folded.
+pub(crate) fn inherits_statically<T, Base>() -> bool
+where
+    T: GodotClass,
+    Base: GodotClass,
+{
+    let current = TypeId::of::<T>();
+
+    if current == TypeId::of::<Base>() {
+        true
+    } else if current == TypeId::of::<()>() {
+        // End of the chain, `()` being the base of `Object`.
+        false
+    } else {
+        inherits_statically::<T::Base, Base>()
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::obj::{dom, mem};
+
+    macro_rules! test_class {
+        ($Class:ident : $Base:ty) => {
+            struct $Class;
+
+            impl GodotClass for $Class {
+                type Base = $Base;
+                type Declarer = dom::EngineDomain;
+                type Mem = mem::ManualMemory;
+
+                const CLASS_NAME: &'static str = stringify!($Class);
+            }
+        };
+    }
+
+    test_class!(Root: ());
+    test_class!(Middle: Root);
+    test_class!(Leaf: Middle);
+    test_class!(Unrelated: Root);
+
+    #[test]
+    fn static_inheritance() {
+        assert!(inherits_statically::<Leaf, Leaf>());
+        assert!(inherits_statically::<Leaf, Middle>());
+        assert!(inherits_statically::<Leaf, Root>());
+        assert!(inherits_statically::<Unrelated, Root>());
+
+        assert!(!inherits_statically::<Root, Leaf>());
+        assert!(!inherits_statically::<Middle, Leaf>());
+        assert!(!inherits_statically::<Leaf, Unrelated>());
+    }
+}
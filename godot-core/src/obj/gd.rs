@@ -19,8 +19,8 @@ use crate::builtin::meta::{ClassName, VariantMetadata};
 use crate::builtin::{FromVariant, ToVariant, Variant, VariantConversionError};
 use crate::obj::dom::Domain as _;
 use crate::obj::mem::Memory as _;
-use crate::obj::{cap, dom, mem, GodotClass, Inherits, Share};
-use crate::obj::{GdMut, GdRef, InstanceId};
+use crate::obj::{cap, class_tag, dom, mem, GodotClass, Inherits, Share};
+use crate::obj::{GdMut, GdRef, GdView, InstanceId};
 use crate::storage::InstanceStorage;
 use crate::{callbacks, engine, out};
 
@@ -138,7 +138,8 @@ where
     ///   reference to the user instance. This can happen through re-entrancy (Rust -> GDScript -> Rust call).
     // Note: possible names: write/read, hold/hold_mut, r/w, r/rw, ...
     pub fn bind(&self) -> GdRef<T> {
-        GdRef::from_cell(self.storage().get())
+        crate::gdext_instrument!(count Bind);
+        self.storage().get()
     }
 
     /// Hands out a guard for an exclusive borrow, through which the user instance can be read and written.
@@ -153,13 +154,12 @@ where
     /// * If there is an ongoing function call from GDScript to Rust, which currently holds a `&T` or `&mut T`
     ///   reference to the user instance. This can happen through re-entrancy (Rust -> GDScript -> Rust call).
     pub fn bind_mut(&mut self) -> GdMut<T> {
-        GdMut::from_cell(self.storage().get_mut())
+        crate::gdext_instrument!(count BindMut);
+        self.storage().get_mut()
     }
 
     /// Storage object associated with the extension instance
-    // FIXME proper + safe interior mutability, also that Clippy is happy
-    #[allow(clippy::mut_from_ref)]
-    pub(crate) fn storage(&self) -> &mut InstanceStorage<T> {
+    pub(crate) fn storage(&self) -> &InstanceStorage<T> {
         let callbacks = crate::storage::nop_instance_callbacks();
 
         unsafe {
@@ -212,11 +212,7 @@ impl<T: GodotClass> Gd<T> {
     }
 
     fn from_opaque(opaque: OpaqueObject) -> Self {
-        let obj = Self {
-            opaque,
-            cached_instance_id: std::cell::Cell::new(None),
-            _marker: PhantomData,
-        };
+        let obj = Self::from_opaque_with_id(opaque, None);
 
         // Initialize instance ID cache
         let id = unsafe { interface_fn!(object_get_instance_id)(obj.obj_sys()) };
@@ -227,6 +223,15 @@ impl<T: GodotClass> Gd<T> {
         obj
     }
 
+    /// Like [`Self::from_opaque`], but takes over an already known instance ID instead of querying the engine.
+    fn from_opaque_with_id(opaque: OpaqueObject, instance_id: Option<InstanceId>) -> Self {
+        Self {
+            opaque,
+            cached_instance_id: std::cell::Cell::new(instance_id),
+            _marker: PhantomData,
+        }
+    }
+
     /// Returns the instance ID of this object, or `None` if the object is dead.
     pub fn instance_id_or_none(&self) -> Option<InstanceId> {
         let known_id = match self.cached_instance_id.get() {
@@ -238,8 +243,11 @@ impl<T: GodotClass> Gd<T> {
         };
 
         // Refreshes the internal cached ID on every call, as we cannot be sure that the object has not been
-        // destroyed since last time. The only reliable way to find out is to call is_instance_id_valid().
-        if engine::utilities::is_instance_id_valid(known_id.to_i64()) {
+        // destroyed since last time. Godot's ObjectDB lookup validates the ID (which is never reused), so this is
+        // equivalent to is_instance_id_valid(), but avoids the utility-function call.
+        // SAFETY: Godot looks up ID in ObjectDB and returns null if not found.
+        let object_ptr = unsafe { interface_fn!(object_get_instance_from_id)(known_id.to_u64()) };
+        if object_ptr == self.obj_sys() {
             Some(known_id)
         } else {
             self.cached_instance_id.set(None);
@@ -273,6 +281,23 @@ impl<T: GodotClass> Gd<T> {
         self.instance_id_or_none().is_some()
     }
 
+    /// Returns a borrowed handle to the same object, without updating the reference count.
+    ///
+    /// This is cheaper than [`Share::share()`] when a handle needs to be stored temporarily, but only read access is
+    /// needed. For calling mutating methods, use `share()`.
+    /// ```no_run
+    /// # use godot::prelude::*;
+    /// use godot::obj::GdView;
+    ///
+    /// fn visible_nodes(nodes: &[Gd<Node3D>]) -> Vec<GdView<'_, Node3D>> {
+    ///     nodes.iter().map(Gd::view).filter(|node| node.is_visible()).collect()
+    /// }
+    /// ```
+    pub fn view(&self) -> GdView<'_, T> {
+        // SAFETY: weak copy, which is never dropped and cannot outlive self.
+        unsafe { GdView::from_weak(self.reinterpret_weak::<T>()) }
+    }
+
     /// **Upcast:** convert into a smart pointer to a base class. Always succeeds.
     ///
     /// Moves out of this value. If you want to create _another_ smart pointer instance,
@@ -291,8 +316,11 @@ impl<T: GodotClass> Gd<T> {
         Base: GodotClass,
         T: Inherits<Base>,
     {
-        self.owned_cast()
-            .expect("Upcast failed. This is a bug; please report it.")
+        // Statically known to succeed, so no engine call is needed. Relies on the same pointer identity as Deref.
+        // SAFETY: T inherits Base; self is forgotten, transferring the reference.
+        let upcast = unsafe { self.reinterpret_weak::<Base>() };
+        std::mem::forget(self);
+        upcast
     }
 
     /// **Downcast:** try to convert into a smart pointer to a derived class.
@@ -354,22 +382,44 @@ impl<T: GodotClass> Gd<T> {
     where
         U: GodotClass,
     {
-        let class_name = ClassName::of::<U>();
-        let class_tag = interface_fn!(classdb_get_class_tag)(class_name.string_sys());
-        let cast_object_ptr = interface_fn!(object_cast_to)(self.obj_sys(), class_tag);
+        // Identity and upcasts always succeed; only downcasts/cross-casts need the dynamic type check.
+        if class_tag::inherits_statically::<T, U>() {
+            return Some(self.reinterpret_weak::<U>());
+        }
+
+        let cast_object_ptr =
+            interface_fn!(object_cast_to)(self.obj_sys(), U::__class_tag().as_ptr());
+
+        // Create weak object, as ownership will be moved and reference-counter stays the same.
+        // In practice, the cast pointer equals the original one, so the cached instance ID can be reused.
+        if cast_object_ptr == self.obj_sys() {
+            Some(self.reinterpret_weak::<U>())
+        } else {
+            sys::ptr_then(cast_object_ptr, |ptr| Gd::from_obj_sys_weak(ptr))
+        }
+    }
 
-        // Create weak object, as ownership will be moved and reference-counter stays the same
-        sys::ptr_then(cast_object_ptr, |ptr| Gd::from_obj_sys_weak(ptr))
+    /// Creates a weak copy of this pointer with a different static type, without any FFI calls.
+    ///
+    /// # Safety
+    /// The dynamic type of the object must be `U` or derived from it. Either `self` or the return value must be forgotten
+    /// (since reference counts are not updated).
+    unsafe fn reinterpret_weak<U>(&self) -> Gd<U>
+    where
+        U: GodotClass,
+    {
+        Gd::from_opaque_with_id(self.opaque, self.cached_instance_id.get())
     }
 
+    // Only called by mem::StaticRefCount, i.e. when `T` inherits RefCounted either statically, or per dynamic type check.
     pub(crate) fn as_ref_counted<R>(&self, apply: impl Fn(&mut engine::RefCounted) -> R) -> R {
         debug_assert!(
             self.is_instance_valid(),
             "as_ref_counted() on freed instance; maybe forgot to increment reference count?"
         );
 
-        let tmp = unsafe { self.ffi_cast::<engine::RefCounted>() };
-        let mut tmp = tmp.expect("object expected to inherit RefCounted");
+        // SAFETY: object inherits RefCounted (see above); tmp is forgotten below.
+        let mut tmp = unsafe { self.reinterpret_weak::<engine::RefCounted>() };
         let return_val =
             <engine::RefCounted as GodotClass>::Declarer::scoped_mut(&mut tmp, |obj| apply(obj));
 
@@ -380,9 +430,8 @@ impl<T: GodotClass> Gd<T> {
     pub(crate) fn as_object<R>(&self, apply: impl Fn(&mut engine::Object) -> R) -> R {
         // Note: no validity check; this could be called by to_string(), which can be called on dead instances
 
-        let tmp = unsafe { self.ffi_cast::<engine::Object>() };
-        let mut tmp = tmp.expect("object expected to inherit Object; should never fail");
-        // let return_val = apply(tmp.inner_mut());
+        // SAFETY: every class inherits Object; tmp is forgotten below.
+        let mut tmp = unsafe { self.reinterpret_weak::<engine::Object>() };
         let return_val =
             <engine::Object as GodotClass>::Declarer::scoped_mut(&mut tmp, |obj| apply(obj));
 
@@ -585,7 +634,9 @@ impl<T: GodotClass> Drop for Gd<T> {
 impl<T: GodotClass> Share for Gd<T> {
     fn share(&self) -> Self {
         out!("Gd::share");
-        Self::from_opaque(self.opaque).with_inc_refcount()
+
+        // Take over the cached instance ID, which saves a query to the engine.
+        Self::from_opaque_with_id(self.opaque, self.cached_instance_id.get()).with_inc_refcount()
     }
 }
 
@@ -0,0 +1,67 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use std::fmt::{Debug, Formatter, Result as FmtResult};
+use std::marker::PhantomData;
+use std::mem::ManuallyDrop;
+use std::ops::Deref;
+
+use crate::obj::{Gd, GodotClass};
+
+/// Non-owning handle to an object, borrowed from a [`Gd`] smart pointer.
+///
+/// Acts like a `&Gd<T>` (through `Deref`), but is an owned value that can be stored and passed around, while creating
+/// and dropping it does not touch the reference count and does not call into the engine. If you need to keep the
+/// object beyond the lifetime of the original `Gd`, call [`Share::share()`] on the view.
+///
+/// The view only gives shared access. Handing out `&mut Gd<T>` or `&mut T` would allow safe code to move the weak
+/// handle out (e.g. with `std::mem::swap()`) and release a reference that was never acquired:
+/// ```compile_fail
+/// # use godot::prelude::*;
+/// fn replace(node: &Gd<Node3D>, other: &Gd<Node3D>) {
+///     *node.view() = other.share(); // error: cannot assign through `Deref`
+/// }
+/// ```
+/// ```compile_fail
+/// # use godot::prelude::*;
+/// fn swap(node: &Gd<Node3D>, other: &mut Gd<Node3D>) {
+///     std::mem::swap(&mut *node.view(), &mut **other); // error: no `DerefMut`
+/// }
+/// ```
+///
+/// See [`Gd::view()`] for usage.
+///
+/// [`Share::share()`]: crate::obj::Share::share
+pub struct GdView<'a, T: GodotClass> {
+    // Weak copy; never dropped, as the reference count was never incremented.
+    gd: ManuallyDrop<Gd<T>>,
+    _borrow: PhantomData<&'a Gd<T>>,
+}
+
+impl<'a, T: GodotClass> GdView<'a, T> {
+    /// # Safety
+    /// `gd` must be a weak copy (no reference-count increment) of a `Gd` that lives at least for `'a`.
+    pub(crate) unsafe fn from_weak(gd: Gd<T>) -> Self {
+        Self {
+            gd: ManuallyDrop::new(gd),
+            _borrow: PhantomData,
+        }
+    }
+}
+
+impl<T: GodotClass> Deref for GdView<'_, T> {
+    type Target = Gd<T>;
+
+    fn deref(&self) -> &Gd<T> {
+        &self.gd
+    }
+}
+
+impl<T: GodotClass> Debug for GdView<'_, T> {
+    fn fmt(&self, f: &mut Formatter<'_>) -> FmtResult {
+        crate::engine::debug_string(&self.gd, f, "GdView")
+    }
+}
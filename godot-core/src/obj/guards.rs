@@ -8,18 +8,33 @@
 use std::cell;
 use std::fmt::Debug;
 use std::ops::{Deref, DerefMut};
+use std::sync::{RwLockReadGuard, RwLockWriteGuard};
 
 /// Immutably/shared bound reference guard for a [`Gd`][crate::obj::Gd] smart pointer.
 ///
 /// See [`Gd::bind`][crate::obj::Gd::bind] for usage.
 #[derive(Debug)]
 pub struct GdRef<'a, T> {
-    cell_ref: cell::Ref<'a, T>,
+    guard: RefGuard<'a, T>,
+}
+
+#[derive(Debug)]
+enum RefGuard<'a, T> {
+    Cell(cell::Ref<'a, T>),
+    Lock(RwLockReadGuard<'a, T>),
 }
 
 impl<'a, T> GdRef<'a, T> {
     pub(crate) fn from_cell(cell_ref: cell::Ref<'a, T>) -> Self {
-        Self { cell_ref }
+        Self {
+            guard: RefGuard::Cell(cell_ref),
+        }
+    }
+
+    pub(crate) fn from_lock(lock_guard: RwLockReadGuard<'a, T>) -> Self {
+        Self {
+            guard: RefGuard::Lock(lock_guard),
+        }
     }
 }
 
@@ -27,7 +42,10 @@ impl<T> Deref for GdRef<'_, T> {
     type Target = T;
 
     fn deref(&self) -> &T {
-        self.cell_ref.deref()
+        match &self.guard {
+            RefGuard::Cell(cell_ref) => cell_ref.deref(),
+            RefGuard::Lock(lock_guard) => lock_guard.deref(),
+        }
     }
 }
 
@@ -40,12 +58,26 @@ impl<T> Deref for GdRef<'_, T> {
 /// See [`Gd::bind_mut`][crate::obj::Gd::bind_mut] for usage.
 #[derive(Debug)]
 pub struct GdMut<'a, T> {
-    cell_ref: cell::RefMut<'a, T>,
+    guard: MutGuard<'a, T>,
+}
+
+#[derive(Debug)]
+enum MutGuard<'a, T> {
+    Cell(cell::RefMut<'a, T>),
+    Lock(RwLockWriteGuard<'a, T>),
 }
 
 impl<'a, T> GdMut<'a, T> {
     pub(crate) fn from_cell(cell_ref: cell::RefMut<'a, T>) -> Self {
-        Self { cell_ref }
+        Self {
+            guard: MutGuard::Cell(cell_ref),
+        }
+    }
+
+    pub(crate) fn from_lock(lock_guard: RwLockWriteGuard<'a, T>) -> Self {
+        Self {
+            guard: MutGuard::Lock(lock_guard),
+        }
     }
 }
 
@@ -53,12 +85,18 @@ impl<T> Deref for GdMut<'_, T> {
     type Target = T;
 
     fn deref(&self) -> &T {
-        self.cell_ref.deref()
+        match &self.guard {
+            MutGuard::Cell(cell_ref) => cell_ref.deref(),
+            MutGuard::Lock(lock_guard) => lock_guard.deref(),
+        }
     }
 }
 
 impl<T> DerefMut for GdMut<'_, T> {
     fn deref_mut(&mut self) -> &mut T {
-        self.cell_ref.deref_mut()
+        match &mut self.guard {
+            MutGuard::Cell(cell_ref) => cell_ref.deref_mut(),
+            MutGuard::Lock(lock_guard) => lock_guard.deref_mut(),
+        }
     }
 }
\ No newline at end of file
@@ -13,14 +13,18 @@
 
 mod as_arg;
 mod base;
+mod class_tag;
 mod gd;
+mod gd_view;
 mod guards;
 mod instance_id;
 mod traits;
 
 pub use as_arg::*;
 pub use base::*;
+pub use class_tag::*;
 pub use gd::*;
+pub use gd_view::*;
 pub use guards::*;
 pub use instance_id::*;
 pub use traits::*;
\ No newline at end of file
@@ -5,7 +5,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-use crate::obj::Base;
+use crate::obj::{Base, ClassTag};
 
 use godot_ffi as sys;
 
@@ -30,8 +30,80 @@ where
     ///
     /// This may deviate from the Rust struct name: `HttpRequest::CLASS_NAME == "HTTPRequest"`.
     const CLASS_NAME: &'static str;
+
+    /// How access to the Rust instance is guarded, for user-defined classes. Has no effect on engine classes.
+    ///
+    /// Selected with `#[class(storage = "...")]` or `#[class(unsafe_storage = "...")]`; see [`StoragePolicy`] for the options.
+    const STORAGE: StoragePolicy = StoragePolicy::Checked;
+
+    /// Tag of this class in Godot's `ClassDB`, used for dynamic casts.
+    ///
+    /// Generated impls cache the tag in a static, so it is looked up only once. This default impl does not cache.
+    #[doc(hidden)]
+    fn __class_tag() -> ClassTag {
+        ClassTag::lookup::<Self>()
+    }
+}
+
+/// Strategy to guard access to the Rust instance of a user-defined class, stored inside a Godot object.
+///
+/// Affects calls from Godot into the instance (`#[func]` methods, virtual methods like `ready`). Borrows through
+/// [`Gd::bind()`][crate::obj::Gd::bind] and [`Gd::bind_mut()`][crate::obj::Gd::bind_mut] are always checked.
+#[derive(Copy, Clone, Eq, PartialEq, Debug)]
+pub enum StoragePolicy {
+    /// Borrows are tracked at runtime, like with [`RefCell`][std::cell::RefCell]. This is the default.
+    ///
+    /// Methods taking `&self` acquire a shared borrow, methods taking `&mut self` an exclusive one. Conflicting
+    /// borrows (e.g. through re-entrant calls Rust -> GDScript -> Rust) cause a panic.
+    Checked,
+
+    /// Like `Checked` in debug builds. In release builds, calls from Godot skip borrow tracking altogether.
+    ///
+    /// Only use this for classes which are accessed from a single thread, and whose `#[func]` methods never call back
+    /// into GDScript code that could re-enter the same instance. Re-entrant calls (e.g. Rust -> GDScript -> Rust)
+    /// create aliased `&mut` references, which is **undefined behavior**. Debug builds find such cases through panics.
+    ///
+    /// Since this is not checked, the class must additionally implement the unsafe marker trait [`UncheckedStorage`]:
+    /// ```no_run
+    /// # use godot::prelude::*;
+    /// use godot::obj::UncheckedStorage;
+    ///
+    /// #[derive(GodotClass)]
+    /// #[class(unsafe_storage = "unchecked")]
+    /// struct Particle {
+    ///     speed: f32,
+    /// }
+    ///
+    /// // SAFETY: Particle's methods never call into GDScript, so they are not re-entered.
+    /// unsafe impl UncheckedStorage for Particle {}
+    /// ```
+    Unchecked,
+
+    /// Borrows are guarded by a reader-writer lock instead of a `RefCell`, and the Godot reference count is atomic.
+    ///
+    /// For classes whose instances are accessed from multiple threads, e.g. by Godot's `WorkerThreadPool` or
+    /// thread-safe servers. Multiple `&self` calls proceed in parallel; a `&mut self` call waits until all others
+    /// have finished. Unlike `Checked`, conflicting borrows on the _same_ thread do not panic but deadlock, so
+    /// re-entrant calls still need to be avoided.
+    ///
+    /// The class must be `Send + Sync`, which `#[derive(GodotClass)]` checks at compile time. This rules out fields
+    /// like `Rc`, `Cell` or `Gd` (including `#[base]`); share such state through thread-safe types instead.
+    ///
+    /// Like `Local`, a panic during `bind_mut()` does not make later borrows fail: the lock's poisoning is ignored, and
+    /// the instance keeps whatever state the panicking code left behind.
+    ///
+    /// `#[class(storage = "sync")]`
+    Sync,
 }
 
+/// Marker for classes with [`StoragePolicy::Unchecked`], required by `#[class(unsafe_storage = "unchecked")]`.
+///
+/// # Safety
+/// Calls from Godot into the instance (`#[func]` methods, virtual methods) must never overlap with each other or with
+/// a [`Gd::bind_mut()`][crate::obj::Gd::bind_mut] guard of the same instance. In particular, no such call may
+/// re-enter the instance through GDScript or signals, and the instance must only be accessed from one thread.
+pub unsafe trait UncheckedStorage: GodotClass {}
+
 /// Unit impl only exists to represent "no base", and is used for exactly one class: `Object`.
 impl GodotClass for () {
     type Base = ();
@@ -147,12 +219,21 @@ pub mod cap {
     pub trait ImplementsGodotExports: GodotClass {
         #[doc(hidden)]
         fn __register_exports();
+
+        /// Direct accessors of the exported properties, used by the `set_func`/`get_func` class callbacks.
+        #[doc(hidden)]
+        fn __property_table() -> Option<&'static crate::private::PropertyTable<Self>>
+        where
+            Self: Sized,
+        {
+            None
+        }
     }
 
     /// Auto-implemented for `#[godot_api] impl GodotExt for MyClass` blocks
     pub trait ImplementsGodotExt: GodotClass {
         #[doc(hidden)]
-        fn __virtual_call(_name: &str) -> sys::GDExtensionClassCallVirtual;
+        fn __virtual_call(_name: &crate::builtin::StringName) -> sys::GDExtensionClassCallVirtual;
     }
 }
 
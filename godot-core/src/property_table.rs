@@ -0,0 +1,197 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+//! Direct access to `#[export]` properties, bypassing method dispatch.
+//!
+//! When a property is set or read through `Object::set()`/`get()` -- which is what GDScript property syntax, the inspector,
+//! `AnimationPlayer` and `Tween` end up calling -- Godot first offers the access to the class's `set_func`/`get_func`,
+//! before it falls back to looking up the registered setter/getter method and calling it through varcall.
+//! `#[derive(GodotClass)]` installs these callbacks for classes with exported fields; they look up the property in a
+//! [`PropertyTable`] and call the Rust setter/getter directly.
+//!
+//! No separate ptrcall accessors are generated. The getter and setter are `#[func]`s, which are already registered with
+//! a ptrcall function, used by callers that know the types (e.g. statically typed GDScript calling `get_value()`).
+//! Property access itself, including `AnimationPlayer` and `Tween`, goes through `Object::set()`/`get()`, whose ABI is
+//! `Variant`-based; so the one `Variant` conversion per access in this table is the minimum for that path.
+
+use once_cell::sync::OnceCell;
+
+use crate::builtin::{StringName, Variant};
+
+/// Accessors of one exported property, generated by `#[derive(GodotClass)]` from its `getter` and `setter`.
+pub struct PropertyAccessor<T> {
+    pub name: &'static str,
+
+    pub get: fn(&T) -> Variant,
+
+    /// Returns `false` if the value cannot be converted to the setter's parameter type.
+    pub set: fn(&mut T, &Variant) -> bool,
+}
+
+/// Property accessors of one class, looked up by `StringName` identity.
+///
+/// Intended to be stored in a `static`. The lookup index is built on first use, once the engine is available.
+pub struct PropertyTable<T: 'static> {
+    accessors: &'static [PropertyAccessor<T>],
+    index: OnceCell<Index>,
+}
+
+impl<T: 'static> PropertyTable<T> {
+    pub const fn new(accessors: &'static [PropertyAccessor<T>]) -> Self {
+        Self {
+            accessors,
+            index: OnceCell::new(),
+        }
+    }
+
+    /// Returns the accessors of the property `name`, or `None` if it is not exported by this class.
+    #[inline]
+    pub fn find(&self, name: &StringName) -> Option<&PropertyAccessor<T>> {
+        let index = self.index.get_or_init(|| Index::new(self.accessors));
+
+        index
+            .hash
+            .get(name.interned_id())
+            .map(|i| &self.accessors[i])
+    }
+}
+
+struct Index {
+    hash: PerfectHash,
+
+    // Keeps the names interned, so that their identities used as keys stay valid.
+    _names: Vec<StringName>,
+}
+
+// SAFETY: the names are never accessed after construction; they only hold a reference to Godot's interned data, which
+// is reference-counted thread-safely.
+unsafe impl Send for Index {}
+unsafe impl Sync for Index {}
+
+impl Index {
+    fn new<T>(accessors: &[PropertyAccessor<T>]) -> Self {
+        let names: Vec<StringName> = accessors
+            .iter()
+            .map(|accessor| StringName::from(accessor.name))
+            .collect();
+
+        let keys: Vec<usize> = names.iter().map(StringName::interned_id).collect();
+
+        Self {
+            hash: PerfectHash::new(&keys),
+            _names: names,
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Collision-free hash table over a fixed set of non-zero keys, mapping each key to its position in that set.
+///
+/// Keys are interned string pointers, so a lookup is one multiplication, one load and one comparison. Suitable
+/// multiplier and table size are searched once, when the table is built.
+struct PerfectHash {
+    multiplier: u64,
+    shift: u32,
+    slots: Box<[Slot]>,
+}
+
+#[derive(Copy, Clone)]
+struct Slot {
+    /// 0 marks an empty slot.
+    key: usize,
+    index: usize,
+}
+
+impl PerfectHash {
+    /// Attempts per table size, before the table is doubled.
+    const ATTEMPTS: u64 = 32;
+
+    fn new(keys: &[usize]) -> Self {
+        debug_assert!(keys.iter().all(|&key| key != 0), "keys must be non-zero");
+
+        // Start at load factor <= 1/2; there are no duplicate keys, so some size always succeeds.
+        let mut bits = (keys.len() * 2).next_power_of_two().trailing_zeros().max(1);
+        loop {
+            for attempt in 0..Self::ATTEMPTS {
+                if let Some(table) = Self::try_build(keys, bits, splitmix64(attempt) | 1) {
+                    return table;
+                }
+            }
+            bits += 1;
+        }
+    }
+
+    fn try_build(keys: &[usize], bits: u32, multiplier: u64) -> Option<Self> {
+        let mut table = Self {
+            multiplier,
+            shift: 64 - bits,
+            slots: vec![Slot { key: 0, index: 0 }; 1 << bits].into_boxed_slice(),
+        };
+
+        for (index, &key) in keys.iter().enumerate() {
+            let slot = &mut table.slots[Self::slot_index(multiplier, table.shift, key)];
+            if slot.key != 0 {
+                return None;
+            }
+            *slot = Slot { key, index };
+        }
+
+        Some(table)
+    }
+
+    #[inline]
+    fn get(&self, key: usize) -> Option<usize> {
+        let slot = &self.slots[Self::slot_index(self.multiplier, self.shift, key)];
+        if slot.key == key && key != 0 {
+            Some(slot.index)
+        } else {
+            None
+        }
+    }
+
+    #[inline]
+    fn slot_index(multiplier: u64, shift: u32, key: usize) -> usize {
+        ((key as u64).wrapping_mul(multiplier) >> shift) as usize
+    }
+}
+
+fn splitmix64(seed: u64) -> u64 {
+    let mut z = seed.wrapping_add(0x9e37_79b9_7f4a_7c15);
+    z = (z ^ (z >> 30)).wrapping_mul(0xbf58_476d_1ce4_e5b9);
+    z = (z ^ (z >> 27)).wrapping_mul(0x94d0_49bb_1331_11eb);
+    z ^ (z >> 31)
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn perfect_hash_lookup() {
+        // Pointer-like keys: aligned and close together, as produced by an allocator.
+        let keys: Vec<usize> = (1..=200).map(|i| 0x7f00_1000_0000 + i * 48).collect();
+        let table = PerfectHash::new(&keys);
+
+        for (index, &key) in keys.iter().enumerate() {
+            assert_eq!(table.get(key), Some(index));
+        }
+        assert_eq!(table.get(0), None);
+        assert_eq!(table.get(0x7f00_1000_0000 + 8), None);
+        assert_eq!(table.get(usize::MAX), None);
+    }
+
+    #[test]
+    fn perfect_hash_small() {
+        assert_eq!(PerfectHash::new(&[]).get(0x1000), None);
+
+        let table = PerfectHash::new(&[0x1000]);
+        assert_eq!(table.get(0x1000), Some(0));
+        assert_eq!(table.slots.len(), 2);
+    }
+}
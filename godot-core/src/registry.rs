@@ -15,12 +15,15 @@ use sys::interface_fn;
 
 use crate::bind::GodotExt;
 use crate::builtin::meta::ClassName;
-use crate::builtin::StringName;
+use crate::builtin::{StringName, Variant};
 use crate::out;
 use std::any::Any;
+use std::cell::RefCell;
 use std::collections::HashMap;
 use std::fmt::{Debug, Formatter, Result as FmtResult};
 use std::ptr;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex, Once};
 
 /// Piece of information that is gathered by the self-registration ("plugin") system.
 #[derive(Debug)]
@@ -62,6 +65,12 @@ pub enum PluginComponent {
             _class_user_data: *mut std::ffi::c_void,
             instance: sys::GDExtensionClassInstancePtr,
         ),
+
+        /// Whether methods and exports are registered only once the first instance is created (`#[class(lazy_methods)]`).
+        ///
+        /// Until then, they are invisible to `ClassDB`, the editor (inspector, documentation, autocompletion) and GDScript
+        /// static typing; only the class itself is registered.
+        lazy_methods: bool,
     },
 
     /// Collected from `#[godot_api] impl MyClass`
@@ -72,6 +81,23 @@ pub enum PluginComponent {
         generated_register_fn: ErasedRegisterFn,
     },
 
+    /// Collected from `#[derive(GodotClass)]` on structs with `#[export]` fields
+    UserProperties {
+        /// Godot low-level `set` function, dispatching to the exported property's setter
+        set_fn: unsafe extern "C" fn(
+            p_instance: sys::GDExtensionClassInstancePtr,
+            p_name: sys::GDExtensionConstStringNamePtr,
+            p_value: sys::GDExtensionConstVariantPtr,
+        ) -> sys::GDExtensionBool,
+
+        /// Godot low-level `get` function, dispatching to the exported property's getter
+        get_fn: unsafe extern "C" fn(
+            p_instance: sys::GDExtensionClassInstancePtr,
+            p_name: sys::GDExtensionConstStringNamePtr,
+            r_ret: sys::GDExtensionVariantPtr,
+        ) -> sys::GDExtensionBool,
+    },
+
     /// Collected from `#[godot_api] impl GodotExt for MyClass`
     UserVirtuals {
         /// Callback to user-defined `register_class` function
@@ -105,19 +131,42 @@ pub enum PluginComponent {
 
 #[derive(Debug)]
 struct ClassRegistrationInfo {
-    class_name: ClassName,
-    parent_class_name: Option<ClassName>,
+    class_name: &'static str,
+    parent_class_name: Option<&'static str>,
     generated_register_fn: Option<ErasedRegisterFn>,
     user_register_fn: Option<ErasedRegisterFn>,
+    lazy_methods: bool,
     godot_params: sys::GDExtensionClassCreationInfo,
 }
 
+/// Registration functions of a `#[class(lazy_methods)]` class, run when the first instance is created.
+struct LazyMethods {
+    class_name: &'static str,
+    generated_register_fn: Option<ErasedRegisterFn>,
+    user_register_fn: Option<ErasedRegisterFn>,
+
+    /// Runs the registration exactly once; concurrent creators of the same class wait on it.
+    registered: Once,
+}
+
+/// Lazy classes whose methods have not been registered yet.
+static PENDING_LAZY_METHODS: Mutex<Vec<Arc<LazyMethods>>> = Mutex::new(Vec::new());
+
+/// Length of `PENDING_LAZY_METHODS`, so that instance creation can skip the lock once all are registered.
+static PENDING_LAZY_COUNT: AtomicUsize = AtomicUsize::new(0);
+
+thread_local! {
+    /// Lazy classes whose registration is running on this thread.
+    ///
+    /// Register functions may create instances of their own class; those must not wait on the `Once` they run in.
+    static REGISTERING_LAZY_METHODS: RefCell<Vec<&'static str>> = RefCell::new(Vec::new());
+}
+
 /// Registers a class with static type information.
 pub fn register_class<T: GodotExt + cap::GodotInit + cap::ImplementsGodotExt>() {
     // TODO: provide overloads with only some trait impls
 
     out!("Manually register class {}", std::any::type_name::<T>());
-    let class_name = ClassName::of::<T>();
 
     let godot_params = sys::GDExtensionClassCreationInfo {
         to_string_func: Some(callbacks::to_string::<T>),
@@ -132,12 +181,13 @@ pub fn register_class<T: GodotExt + cap::GodotInit + cap::ImplementsGodotExt>()
     };
 
     register_class_raw(ClassRegistrationInfo {
-        class_name,
-        parent_class_name: Some(ClassName::of::<T::Base>()),
+        class_name: T::CLASS_NAME,
+        parent_class_name: Some(<T::Base as GodotClass>::CLASS_NAME),
         generated_register_fn: None,
         user_register_fn: Some(ErasedRegisterFn {
             raw: callbacks::register_class_by_builder::<T>,
         }),
+        lazy_methods: false,
         godot_params,
     });
 }
@@ -151,22 +201,22 @@ pub fn auto_register_classes() {
     // * duplicate impl GodotInit for T
     //
 
-    let mut map = HashMap::<ClassName, ClassRegistrationInfo>::new();
+    // Keyed by the static name: hashing a &str is much cheaper than converting every plugin's name to a StringName.
+    let mut map = HashMap::<&'static str, ClassRegistrationInfo>::new();
 
     crate::private::iterate_plugins(|elem: &ClassPlugin| {
         //out!("* Plugin: {elem:#?}");
 
-        let name = ClassName::from_static(elem.class_name);
         let class_info = map
-            .entry(name.clone())
-            .or_insert_with(|| default_registration_info(name));
+            .entry(elem.class_name)
+            .or_insert_with(|| default_registration_info(elem.class_name));
 
         fill_class_info(elem.component.clone(), class_info);
     });
 
     //out!("Class-map: {map:#?}");
 
-    for info in map.into_values() {
+    for info in sort_for_registration(map) {
         out!("Register class:   {}", info.class_name);
         register_class_raw(info);
     }
@@ -174,6 +224,62 @@ pub fn auto_register_classes() {
     out!("All classes auto-registered.");
 }
 
+/// Registers a class built into the library, outside of the plugin registry.
+///
+/// For classes that are only registered on first use, so that libraries not using them don't register them either.
+pub(crate) fn register_class_components(
+    class_name: &'static str,
+    components: impl IntoIterator<Item = PluginComponent>,
+) {
+    out!("Register class:   {class_name}");
+
+    let mut info = default_registration_info(class_name);
+    for component in components {
+        fill_class_info(component, &mut info);
+    }
+
+    register_class_raw(info);
+}
+
+/// Orders classes so that each one is registered after its base class, as required by Godot.
+///
+/// Classes with equal inheritance depth are ordered by name, so registration is deterministic across runs.
+/// Methods of a base class are needed as soon as a derived instance exists, so base classes are never lazy.
+fn sort_for_registration(
+    mut map: HashMap<&'static str, ClassRegistrationInfo>,
+) -> Vec<ClassRegistrationInfo> {
+    let parents: HashMap<&'static str, &'static str> = map
+        .values()
+        .filter_map(|info| Some((info.class_name, info.parent_class_name?)))
+        .collect();
+
+    for parent in parents.values() {
+        if let Some(parent_info) = map.get_mut(parent) {
+            parent_info.lazy_methods = false;
+        }
+    }
+
+    // Number of base classes that are themselves registered by this library.
+    let depth = |mut class_name: &'static str| {
+        let mut depth = 0;
+        while let Some(&parent) = parents.get(class_name) {
+            if !map.contains_key(parent) {
+                break;
+            }
+            depth += 1;
+            class_name = parent;
+        }
+        depth
+    };
+
+    let depths: HashMap<&'static str, usize> =
+        map.keys().map(|&name| (name, depth(name))).collect();
+
+    let mut ordered: Vec<ClassRegistrationInfo> = map.into_values().collect();
+    ordered.sort_unstable_by_key(|info| (depths[info.class_name], info.class_name));
+    ordered
+}
+
 /// Populate `c` with all the relevant data from `component` (depending on component type).
 fn fill_class_info(component: PluginComponent, c: &mut ClassRegistrationInfo) {
     // out!("|   reg (before):    {c:?}");
@@ -183,13 +289,15 @@ fn fill_class_info(component: PluginComponent, c: &mut ClassRegistrationInfo) {
             base_class_name,
             generated_create_fn,
             free_fn,
+            lazy_methods,
         } => {
-            c.parent_class_name = Some(ClassName::from_static(base_class_name));
+            c.parent_class_name = Some(base_class_name);
             fill_into(
                 &mut c.godot_params.create_instance_func,
                 generated_create_fn,
             );
             c.godot_params.free_instance_func = Some(free_fn);
+            c.lazy_methods = lazy_methods;
         }
 
         PluginComponent::UserMethodBinds {
@@ -198,6 +306,11 @@ fn fill_class_info(component: PluginComponent, c: &mut ClassRegistrationInfo) {
             c.generated_register_fn = Some(generated_register_fn);
         }
 
+        PluginComponent::UserProperties { set_fn, get_fn } => {
+            c.godot_params.set_func = Some(set_fn);
+            c.godot_params.get_func = Some(get_fn);
+        }
+
         PluginComponent::UserVirtuals {
             user_register_fn,
             user_create_fn,
@@ -227,10 +340,11 @@ fn fill_into<T>(dst: &mut Option<T>, src: Option<T>) {
 fn register_class_raw(info: ClassRegistrationInfo) {
     // First register class...
 
-    let class_name = info.class_name;
-    let parent_class_name = info
-        .parent_class_name
-        .expect("class defined (parent_class_name)");
+    let class_name = ClassName::from_static(info.class_name);
+    let parent_class_name = ClassName::from_static(
+        info.parent_class_name
+            .expect("class defined (parent_class_name)"),
+    );
 
     unsafe {
         // Try to register class...
@@ -251,17 +365,79 @@ fn register_class_raw(info: ClassRegistrationInfo) {
         );
     }
 
-    // ...then custom symbols
+    // ...then custom symbols, unless deferred to the first instance.
+    if info.lazy_methods {
+        let mut pending = PENDING_LAZY_METHODS.lock().unwrap();
+        pending.push(Arc::new(LazyMethods {
+            class_name: info.class_name,
+            generated_register_fn: info.generated_register_fn,
+            user_register_fn: info.user_register_fn,
+            registered: Once::new(),
+        }));
+        PENDING_LAZY_COUNT.store(pending.len(), Ordering::Release);
+    } else {
+        register_class_symbols(info.generated_register_fn, info.user_register_fn);
+    }
+}
+
+/// Registers methods and exports of a `#[class(lazy_methods)]` class, if not done yet.
+///
+/// Called on every instance creation; a single atomic load unless some lazy class is still pending.
+fn ensure_lazy_methods_registered(class_name: &'static str) {
+    if PENDING_LAZY_COUNT.load(Ordering::Acquire) == 0 {
+        return;
+    }
 
+    let is_registering_here =
+        REGISTERING_LAZY_METHODS.with(|registering| registering.borrow().contains(&class_name));
+    if is_registering_here {
+        return;
+    }
+
+    // Only look up the entry under the lock. Register functions run with the lock released, since they may create
+    // instances of other lazy classes, which come through here again.
+    let lazy = PENDING_LAZY_METHODS
+        .lock()
+        .unwrap()
+        .iter()
+        .find(|lazy| lazy.class_name == class_name)
+        .cloned();
+
+    if let Some(lazy) = lazy {
+        lazy.registered.call_once(|| {
+            out!("Register lazy methods:   {class_name}");
+
+            REGISTERING_LAZY_METHODS.with(|registering| registering.borrow_mut().push(class_name));
+            register_class_symbols(lazy.generated_register_fn, lazy.user_register_fn);
+            REGISTERING_LAZY_METHODS.with(|registering| registering.borrow_mut().pop());
+
+            let mut pending = PENDING_LAZY_METHODS.lock().unwrap();
+            pending.retain(|other| !Arc::ptr_eq(other, &lazy));
+            PENDING_LAZY_COUNT.store(pending.len(), Ordering::Release);
+        });
+    }
+}
+
+/// Forgets lazy classes whose methods were never registered, so that a re-initialized library starts from scratch.
+pub(crate) fn clear_lazy_methods() {
+    let mut pending = PENDING_LAZY_METHODS.lock().unwrap();
+    pending.clear();
+    PENDING_LAZY_COUNT.store(0, Ordering::Release);
+}
+
+fn register_class_symbols(
+    generated_register_fn: Option<ErasedRegisterFn>,
+    user_register_fn: Option<ErasedRegisterFn>,
+) {
     //let mut class_builder = crate::builder::ClassBuilder::<?>::new();
     let mut class_builder = 0; // TODO dummy argument; see callbacks
 
     // First call generated (proc-macro) registration function, then user-defined one.
     // This mimics the intuition that proc-macros are running "before" normal runtime code.
-    if let Some(register_fn) = info.generated_register_fn {
+    if let Some(register_fn) = generated_register_fn {
         (register_fn.raw)(&mut class_builder);
     }
-    if let Some(register_fn) = info.user_register_fn {
+    if let Some(register_fn) = user_register_fn {
         (register_fn.raw)(&mut class_builder);
     }
 }
@@ -287,6 +463,8 @@ pub mod callbacks {
         T: GodotClass,
         F: FnOnce(Base<T::Base>) -> T,
     {
+        ensure_lazy_methods_registered(T::CLASS_NAME);
+
         let class_name = ClassName::of::<T>();
         let base_class_name = ClassName::of::<T::Base>();
 
@@ -321,21 +499,81 @@ pub mod callbacks {
         _class_user_data: *mut std::ffi::c_void,
         instance: sys::GDExtensionClassInstancePtr,
     ) {
-        let storage = as_storage::<T>(instance);
-        storage.mark_destroyed_by_godot();
-        let _drop = Box::from_raw(storage as *mut InstanceStorage<_>);
+        // Godot hands over ownership here; no other references to the storage are live.
+        let storage = instance as *mut InstanceStorage<T>;
+        (*storage).mark_destroyed_by_godot();
+        let _drop = Box::from_raw(storage);
     }
 
     pub unsafe extern "C" fn get_virtual<T: cap::ImplementsGodotExt>(
         _class_user_data: *mut std::ffi::c_void,
         name: sys::GDExtensionConstStringNamePtr,
     ) -> sys::GDExtensionClassCallVirtual {
+        crate::gdext_instrument!(time GetVirtual);
+
         // This string is not ours, so we cannot call the destructor on it.
-        let borrowed_string = StringName::from_string_sys(sys::force_mut_ptr(name));
-        let method_name = borrowed_string.to_string();
-        std::mem::forget(borrowed_string);
+        // It is compared against interned names by identity, without allocating or calling into Godot.
+        let borrowed_string =
+            std::mem::ManuallyDrop::new(StringName::from_string_sys(sys::force_mut_ptr(name)));
 
-        T::__virtual_call(method_name.as_str())
+        T::__virtual_call(&borrowed_string)
+    }
+
+    pub unsafe extern "C" fn set_property<T: cap::ImplementsGodotExports>(
+        instance: sys::GDExtensionClassInstancePtr,
+        name: sys::GDExtensionConstStringNamePtr,
+        value: sys::GDExtensionConstVariantPtr,
+    ) -> sys::GDExtensionBool {
+        crate::gdext_instrument!(time PropertyAccess);
+
+        // Not ours, see get_virtual().
+        let name =
+            std::mem::ManuallyDrop::new(StringName::from_string_sys(sys::force_mut_ptr(name)));
+
+        // Unknown properties (e.g. those of a base class) and failed conversions fall back to Godot's regular lookup,
+        // which also reports errors.
+        let accessor = match T::__property_table().and_then(|table| table.find(&name)) {
+            Some(accessor) => accessor,
+            None => return false as sys::GDExtensionBool,
+        };
+
+        let value = Variant::borrow_var_sys(value);
+        let success = crate::private::handle_panic(
+            || accessor.name,
+            || as_storage::<T>(instance).map_mut(|inst| (accessor.set)(inst, value)),
+        );
+
+        success.unwrap_or(false) as sys::GDExtensionBool
+    }
+
+    pub unsafe extern "C" fn get_property<T: cap::ImplementsGodotExports>(
+        instance: sys::GDExtensionClassInstancePtr,
+        name: sys::GDExtensionConstStringNamePtr,
+        ret: sys::GDExtensionVariantPtr,
+    ) -> sys::GDExtensionBool {
+        crate::gdext_instrument!(time PropertyAccess);
+
+        let name =
+            std::mem::ManuallyDrop::new(StringName::from_string_sys(sys::force_mut_ptr(name)));
+
+        let accessor = match T::__property_table().and_then(|table| table.find(&name)) {
+            Some(accessor) => accessor,
+            None => return false as sys::GDExtensionBool,
+        };
+
+        let value = crate::private::handle_panic(
+            || accessor.name,
+            || as_storage::<T>(instance).map(|inst| (accessor.get)(inst)),
+        );
+
+        match value {
+            Some(value) => {
+                // `ret` points to an initialized (nil) variant; assignment drops the previous value.
+                *Variant::ptr_from_sys_mut(ret) = value;
+                true as sys::GDExtensionBool
+            }
+            None => false as sys::GDExtensionBool,
+        }
     }
 
     pub unsafe extern "C" fn to_string<T: GodotExt>(
@@ -406,12 +644,13 @@ pub mod callbacks {
 // Substitute for Default impl
 // Yes, bindgen can implement Default, but only for _all_ types (with single exceptions).
 // For FFI types, it's better to have explicit initialization in the general case though.
-fn default_registration_info(class_name: ClassName) -> ClassRegistrationInfo {
+fn default_registration_info(class_name: &'static str) -> ClassRegistrationInfo {
     ClassRegistrationInfo {
         class_name,
         parent_class_name: None,
         generated_register_fn: None,
         user_register_fn: None,
+        lazy_methods: false,
         godot_params: default_creation_info(),
     }
 }
@@ -4,20 +4,33 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-use crate::obj::GodotClass;
+use crate::obj::{GdMut, GdRef, GodotClass, StoragePolicy};
 use crate::out;
 use godot_ffi as sys;
 
 use std::any::type_name;
 use std::cell;
+use std::sync::atomic::{AtomicI32, Ordering};
+use std::sync::{PoisonError, RwLock};
 
 /// Manages storage and lifecycle of user's extension class instances.
 pub struct InstanceStorage<T: GodotClass> {
-    user_instance: cell::RefCell<T>,
+    user_instance: InstanceCell<T>,
 
     // Declared after `user_instance`, is dropped last
     pub lifecycle: Lifecycle,
-    godot_ref_count: i32,
+
+    // Atomic, because RefCounted::reference()/unreference() may be invoked from any thread.
+    godot_ref_count: AtomicI32,
+}
+
+/// Interior mutability for the user instance, depending on [`StoragePolicy`].
+enum InstanceCell<T> {
+    /// `Checked` and `Unchecked` policies: single-threaded.
+    Local(cell::RefCell<T>),
+
+    /// `Sync` policy: multiple readers or one writer, across threads.
+    Sync(RwLock<T>),
 }
 
 #[derive(Copy, Clone, Debug)]
@@ -32,31 +45,28 @@ impl<T: GodotClass> InstanceStorage<T> {
     pub fn construct(user_instance: T) -> Self {
         out!("    Storage::construct             <{}>", type_name::<T>());
 
+        let user_instance = match T::STORAGE {
+            StoragePolicy::Checked | StoragePolicy::Unchecked => {
+                InstanceCell::Local(cell::RefCell::new(user_instance))
+            }
+            StoragePolicy::Sync => InstanceCell::Sync(RwLock::new(user_instance)),
+        };
+
         Self {
-            user_instance: cell::RefCell::new(user_instance),
+            user_instance,
             lifecycle: Lifecycle::Alive,
-            godot_ref_count: 1,
+            godot_ref_count: AtomicI32::new(1),
         }
     }
 
-    pub(crate) fn on_inc_ref(&mut self) {
-        self.godot_ref_count += 1;
-        out!(
-            "    Storage::on_inc_ref (rc={})     <{}>", // -- {:?}",
-            self.godot_ref_count,
-            type_name::<T>(),
-            //self.user_instance
-        );
+    pub(crate) fn on_inc_ref(&self) {
+        self.godot_ref_count.fetch_add(1, Ordering::Relaxed);
+        crate::gdext_instrument!(count RefInc);
     }
 
-    pub(crate) fn on_dec_ref(&mut self) {
-        self.godot_ref_count -= 1;
-        out!(
-            "  | Storage::on_dec_ref (rc={})     <{}>", // -- {:?}",
-            self.godot_ref_count,
-            type_name::<T>(),
-            //self.user_instance
-        );
+    pub(crate) fn on_dec_ref(&self) {
+        self.godot_ref_count.fetch_sub(1, Ordering::Relaxed);
+        crate::gdext_instrument!(count RefDec);
     }
 
     /* pub fn destroy(&mut self) {
@@ -77,26 +87,76 @@ impl<T: GodotClass> InstanceStorage<T> {
         Box::into_raw(Box::new(self))
     }
 
-    pub fn get(&self) -> cell::Ref<T> {
-        self.user_instance.try_borrow().unwrap_or_else(|_e| {
-            panic!(
-                "Gd<T>::bind() failed, already bound; T = {}.\n  \
-                 Make sure there is no &mut T live at the time.\n  \
-                 This often occurs when calling a GDScript function/signal from Rust, which then calls again Rust code.",
-                type_name::<T>()
-            )
-        })
+    pub fn get(&self) -> GdRef<T> {
+        match &self.user_instance {
+            InstanceCell::Local(cell) => {
+                let cell_ref = cell.try_borrow().unwrap_or_else(|_e| {
+                    panic!(
+                        "Gd<T>::bind() failed, already bound; T = {}.\n  \
+                         Make sure there is no &mut T live at the time.\n  \
+                         This often occurs when calling a GDScript function/signal from Rust, which then calls again Rust code.",
+                        type_name::<T>()
+                    )
+                });
+                GdRef::from_cell(cell_ref)
+            }
+
+            // Blocks while another thread holds a write lock. Poisoning is ignored; see `recover_poisoned()`.
+            InstanceCell::Sync(lock) => {
+                GdRef::from_lock(lock.read().unwrap_or_else(recover_poisoned))
+            }
+        }
+    }
+
+    pub fn get_mut(&self) -> GdMut<T> {
+        match &self.user_instance {
+            InstanceCell::Local(cell) => {
+                let cell_ref = cell.try_borrow_mut().unwrap_or_else(|_e| {
+                    panic!(
+                        "Gd<T>::bind_mut() failed, already bound; T = {}.\n  \
+                         Make sure there is no &T or &mut T live at the time.\n  \
+                         This often occurs when calling a GDScript function/signal from Rust, which then calls again Rust code.",
+                        type_name::<T>()
+                    )
+                });
+                GdMut::from_cell(cell_ref)
+            }
+
+            // Blocks while other threads hold read or write locks. Poisoning is ignored; see `recover_poisoned()`.
+            InstanceCell::Sync(lock) => {
+                GdMut::from_lock(lock.write().unwrap_or_else(recover_poisoned))
+            }
+        }
+    }
+
+    /// Runs `f` with a shared reference to the user instance. Used when Godot calls a `&self` method.
+    ///
+    /// Whether the borrow is tracked depends on the class's [`StoragePolicy`].
+    #[inline]
+    pub fn map<R>(&self, f: impl FnOnce(&T) -> R) -> R {
+        match &self.user_instance {
+            // SAFETY: see StoragePolicy::Unchecked; no exclusive borrow is live while Godot calls into the instance.
+            InstanceCell::Local(cell) if Self::is_unchecked() => f(unsafe { &*cell.as_ptr() }),
+            _ => f(&self.get()),
+        }
     }
 
-    pub fn get_mut(&mut self) -> cell::RefMut<T> {
-        self.user_instance.try_borrow_mut().unwrap_or_else(|_e| {
-            panic!(
-                "Gd<T>::bind_mut() failed, already bound; T = {}.\n  \
-                 Make sure there is no &T or &mut T live at the time.\n  \
-                 This often occurs when calling a GDScript function/signal from Rust, which then calls again Rust code.",
-                type_name::<T>()
-            )
-        })
+    /// Runs `f` with an exclusive reference to the user instance. Used when Godot calls a `&mut self` method.
+    ///
+    /// Whether the borrow is tracked depends on the class's [`StoragePolicy`].
+    #[inline]
+    pub fn map_mut<R>(&self, f: impl FnOnce(&mut T) -> R) -> R {
+        match &self.user_instance {
+            // SAFETY: see StoragePolicy::Unchecked; no other borrow is live while Godot calls into the instance.
+            InstanceCell::Local(cell) if Self::is_unchecked() => f(unsafe { &mut *cell.as_ptr() }),
+            _ => f(&mut self.get_mut()),
+        }
+    }
+
+    /// Compile-time constant per class, so the unused branch in `map()`/`map_mut()` is optimized out.
+    #[inline(always)]
+    fn is_unchecked() -> bool {
+        !cfg!(debug_assertions) && matches!(T::STORAGE, StoragePolicy::Unchecked)
     }
 
     pub fn mark_destroyed_by_godot(&mut self) {
@@ -114,20 +174,26 @@ impl<T: GodotClass> InstanceStorage<T> {
 
     #[inline(always)]
     pub fn destroyed_by_godot(&self) -> bool {
-        out!(
-            "    is_d;  self={:?}, val={:?}",
-            self as *const _,
-            self.lifecycle
-        );
         matches!(self.lifecycle, Lifecycle::Destroying | Lifecycle::Dead)
     }
 }
 
+/// Accesses the instance behind a lock poisoned by a panic during an earlier `bind_mut()`.
+///
+/// This is sound: poisoning does not protect memory safety, the `RwLock` still guarantees exclusive access. A panic
+/// can only leave `T` in a state that is valid for its type, but may violate invariants of the user's own code --
+/// the same situation as with the `RefCell` of the `Local` policy, which does not poison. Propagating the poison
+/// instead would make the object permanently unusable, since panics in `#[func]` methods are caught at the FFI
+/// boundary and the object lives on in Godot.
+fn recover_poisoned<G>(poisoned: PoisonError<G>) -> G {
+    poisoned.into_inner()
+}
+
 impl<T: GodotClass> Drop for InstanceStorage<T> {
     fn drop(&mut self) {
         out!(
             "    Storage::drop (rc={})           <{}>", // -- {:?}",
-            self.godot_ref_count,
+            self.godot_ref_count.load(Ordering::Relaxed),
             type_name::<T>(),
             //self.user_instance
         );
@@ -142,15 +208,16 @@ impl<T: GodotClass> Drop for InstanceStorage<T> {
 
 /// Interprets the opaque pointer as pointing to `InstanceStorage<T>`.
 ///
-/// Note: returns reference with unbounded lifetime; intended for local usage
+/// Note: returns reference with unbounded lifetime; intended for local usage.
+/// The reference is shared, since Godot may call into the same instance from multiple threads (see [`StoragePolicy::Sync`]).
 ///
 /// # Safety
 /// `instance_ptr` is assumed to point to a valid instance.
-// FIXME unbounded ref AND &mut out of thin air is a huge hazard -- consider using with_storage(ptr, closure) and drop_storage(ptr)
+// FIXME unbounded ref is a hazard -- consider using with_storage(ptr, closure) and drop_storage(ptr)
 pub unsafe fn as_storage<'u, T: GodotClass>(
     instance_ptr: sys::GDExtensionClassInstancePtr,
-) -> &'u mut InstanceStorage<T> {
-    &mut *(instance_ptr as *mut InstanceStorage<T>)
+) -> &'u InstanceStorage<T> {
+    &*(instance_ptr as *const InstanceStorage<T>)
 }
 
 pub fn nop_instance_callbacks() -> sys::GDExtensionInstanceBindingCallbacks {
@@ -12,10 +12,7 @@ fn main() {
     // For custom path on macOS, iOS, Android etc: see gdnative-sys/build.rs
     let gen_path = Path::new(concat!(env!("CARGO_MANIFEST_DIR"), "/src/gen/"));
 
-    if gen_path.exists() {
-        std::fs::remove_dir_all(gen_path).unwrap_or_else(|e| panic!("failed to delete dir: {e}"));
-    }
-
+    // Not deleted upfront: codegen only rewrites files whose contents changed, to avoid rebuilds.
     run_bindgen(&gen_path.join("gdextension_interface.rs"));
     godot_codegen::generate_sys_files(gen_path);
 }
@@ -42,10 +39,8 @@ fn run_bindgen(out_file: &Path) {
         .generate()
         .expect("failed generate gdextension_interface.h bindings");
 
-    // Write the bindings to the $OUT_DIR/bindings.rs file.
-    bindings
-        .write_to_file(out_file)
-        .expect("failed write gdextension_interface.h bindings to file");
+    // Keep the file (and its modification time) if bindings are unchanged.
+    godot_codegen::write_if_changed(out_file, &bindings.to_string());
 }
 
 //#[cfg(target_os = "macos")]
@@ -21,8 +21,11 @@
 pub(crate) mod gen;
 
 mod godot_ffi;
+mod method_bind_cache;
+mod method_loader;
 mod opaque;
 mod plugins;
+mod varcall_args;
 
 // See https://github.com/dtolnay/paste/issues/69#issuecomment-962418430
 // and https://users.rust-lang.org/t/proc-macros-using-third-party-crate/42465/4
@@ -30,6 +33,8 @@ mod plugins;
 pub use paste;
 
 pub use crate::godot_ffi::{GodotFfi, GodotFuncMarshal};
+pub use crate::method_bind_cache::MethodBindCache;
+pub use crate::varcall_args::{VarcallArgs, VARCALL_INLINE_VARARGS};
 pub use gen::central::*;
 pub use gen::gdextension_interface::*;
 
@@ -0,0 +1,56 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use crate::{GDExtensionMethodBindPtr, TagMethodBind};
+use std::sync::atomic::{AtomicPtr, Ordering};
+
+/// Lazily resolved `MethodBind` pointer, one per generated engine method.
+///
+/// Generated class code declares one `static` of this type inside each method wrapper. The first call
+/// looks up the bind via `classdb_get_method_bind` and stores it; subsequent calls are a single atomic load.
+///
+/// Racing initializations from multiple threads are benign: Godot returns the same pointer for
+/// the same (class, method, hash) triple, so the last store wins with an identical value.
+#[doc(hidden)]
+pub struct MethodBindCache {
+    ptr: AtomicPtr<TagMethodBind>,
+}
+
+impl MethodBindCache {
+    #[allow(clippy::new_without_default)] // must be const, only used in generated statics
+    pub const fn new() -> Self {
+        Self {
+            ptr: AtomicPtr::new(std::ptr::null_mut()),
+        }
+    }
+
+    /// Returns the cached pointer, or runs `lookup` and caches its result if none is present yet.
+    ///
+    /// Null results from `lookup` are not cached, so a failed lookup is retried on the next call.
+    #[inline]
+    pub fn get_or_init<F>(&self, lookup: F) -> GDExtensionMethodBindPtr
+    where
+        F: FnOnce() -> GDExtensionMethodBindPtr,
+    {
+        let cached = self.ptr.load(Ordering::Acquire);
+        if !cached.is_null() {
+            return cached;
+        }
+
+        self.init_cold(lookup)
+    }
+
+    #[cold]
+    #[inline(never)]
+    fn init_cold<F>(&self, lookup: F) -> GDExtensionMethodBindPtr
+    where
+        F: FnOnce() -> GDExtensionMethodBindPtr,
+    {
+        let method_bind = lookup();
+        self.ptr.store(method_bind, Ordering::Release);
+        method_bind
+    }
+}
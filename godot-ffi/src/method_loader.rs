@@ -0,0 +1,91 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use crate::{
+    types, GDExtensionConstStringNamePtr, GDExtensionConstTypePtr, GDExtensionInt,
+    GDExtensionInterface, GDExtensionPtrBuiltInMethod, GDExtensionStringPtr, GDExtensionTypePtr,
+    GDExtensionVariantType, GDEXTENSION_VARIANT_TYPE_STRING, GDEXTENSION_VARIANT_TYPE_STRING_NAME,
+};
+use std::mem::MaybeUninit;
+
+type CtorFn = unsafe extern "C" fn(GDExtensionTypePtr, *const GDExtensionConstTypePtr);
+type DtorFn = unsafe extern "C" fn(GDExtensionTypePtr);
+
+/// Looks up builtin method pointers by name, while the [`GlobalMethodTable`][crate::GlobalMethodTable] is being built.
+///
+/// Since the table is not available yet, `String` and `StringName` are constructed directly through the interface,
+/// on the stack, and destroyed right after each lookup.
+pub(crate) struct BuiltinMethodLoader<'a> {
+    interface: &'a GDExtensionInterface,
+    string_name_from_string: CtorFn,
+    string_destroy: DtorFn,
+    string_name_destroy: DtorFn,
+}
+
+impl<'a> BuiltinMethodLoader<'a> {
+    /// # Safety
+    ///
+    /// `interface` must be the valid, fully populated interface passed by Godot, and `string_name_from_string_index`
+    /// must be the constructor index of `StringName(String from)` in the extension API.
+    pub unsafe fn new(
+        interface: &'a GDExtensionInterface,
+        string_name_from_string_index: i32,
+    ) -> Self {
+        let get_ctor = interface.variant_get_ptr_constructor.unwrap();
+        let get_dtor = interface.variant_get_ptr_destructor.unwrap();
+
+        Self {
+            interface,
+            string_name_from_string: get_ctor(
+                GDEXTENSION_VARIANT_TYPE_STRING_NAME,
+                string_name_from_string_index,
+            )
+            .expect("failed to load GDExtension function `string_name_from_string`"),
+            string_destroy: get_dtor(GDEXTENSION_VARIANT_TYPE_STRING)
+                .expect("failed to load GDExtension function `string_destroy`"),
+            string_name_destroy: get_dtor(GDEXTENSION_VARIANT_TYPE_STRING_NAME)
+                .expect("failed to load GDExtension function `string_name_destroy`"),
+        }
+    }
+
+    /// Returns the ptrcall function for `method_name` on the given builtin type, or `None` if Godot doesn't know it.
+    ///
+    /// # Safety
+    ///
+    /// Must only be called during initialization, on the main thread.
+    pub unsafe fn load(
+        &self,
+        variant_type: GDExtensionVariantType,
+        method_name: &str,
+        hash: GDExtensionInt,
+    ) -> GDExtensionPtrBuiltInMethod {
+        let mut string = MaybeUninit::<types::OpaqueString>::uninit();
+        let string_ptr = string.as_mut_ptr() as GDExtensionStringPtr;
+        let string_new = self.interface.string_new_with_utf8_chars_and_len.unwrap();
+        string_new(
+            string_ptr,
+            method_name.as_ptr() as *const std::os::raw::c_char,
+            method_name.len() as GDExtensionInt,
+        );
+
+        let mut string_name = MaybeUninit::<types::OpaqueStringName>::uninit();
+        let string_name_ptr = string_name.as_mut_ptr() as GDExtensionTypePtr;
+        let args = [string_ptr as GDExtensionConstTypePtr];
+        (self.string_name_from_string)(string_name_ptr, args.as_ptr());
+
+        let get_method = self.interface.variant_get_ptr_builtin_method.unwrap();
+        let method = get_method(
+            variant_type,
+            string_name_ptr as GDExtensionConstStringNamePtr,
+            hash,
+        );
+
+        (self.string_name_destroy)(string_name_ptr);
+        (self.string_destroy)(string_ptr as GDExtensionTypePtr);
+
+        method
+    }
+}
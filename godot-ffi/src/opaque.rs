@@ -12,7 +12,7 @@
 /// Note: due to `align(8)` and not `packed` repr, this type may be bigger than `N` bytes
 /// (which should be OK since C++ just needs to read/write those `N` bytes reliably).
 #[repr(C, align(8))]
-#[derive(Copy, Clone)]
+#[derive(Copy, Clone, Eq, PartialEq)]
 pub struct Opaque<const N: usize> {
     storage: [u8; N],
     marker: std::marker::PhantomData<*const u8>, // disable Send/Sync
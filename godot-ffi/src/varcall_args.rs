@@ -0,0 +1,128 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use std::ptr;
+
+/// Number of varargs that generated vararg wrappers can pass without a heap allocation.
+pub const VARCALL_INLINE_VARARGS: usize = 8;
+
+/// Argument pointer array for vararg calls, stored inline for up to `N` arguments.
+///
+/// Generated vararg wrappers (e.g. `Object::emit_signal()`) collect pointers to their explicit arguments and
+/// varargs in this buffer. `N` is chosen as the number of explicit parameters plus [`VARCALL_INLINE_VARARGS`], so
+/// that common calls stay on the stack; only calls with more arguments spill to a `Vec`.
+#[doc(hidden)]
+pub struct VarcallArgs<T, const N: usize> {
+    inline: [*const T; N],
+    len: usize,
+
+    /// Non-empty iff the arguments did not fit inline. Then holds all of them, not only the excess.
+    heap: Vec<*const T>,
+}
+
+impl<T, const N: usize> VarcallArgs<T, N> {
+    #[inline]
+    pub fn new(args: impl IntoIterator<Item = *const T>) -> Self {
+        let args = args.into_iter();
+
+        let mut result = Self {
+            inline: [ptr::null(); N],
+            len: 0,
+            heap: Vec::new(),
+        };
+
+        let (lower, _) = args.size_hint();
+        if lower > N {
+            result.heap.reserve_exact(lower);
+        }
+
+        for arg in args {
+            result.push(arg);
+        }
+        result
+    }
+
+    #[inline]
+    fn push(&mut self, arg: *const T) {
+        if self.heap.capacity() == 0 && self.len < N {
+            self.inline[self.len] = arg;
+        } else {
+            if self.heap.is_empty() {
+                self.heap.extend_from_slice(&self.inline[..self.len]);
+            }
+            self.heap.push(arg);
+        }
+
+        self.len += 1;
+    }
+
+    /// Pointer to the first argument pointer, as expected by the `p_args` parameter of Godot's call functions.
+    #[inline]
+    pub fn as_ptr(&self) -> *const *const T {
+        if self.heap.is_empty() {
+            self.inline.as_ptr()
+        } else {
+            self.heap.as_ptr()
+        }
+    }
+
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    #[inline]
+    pub fn is_inline(&self) -> bool {
+        self.heap.is_empty()
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[cfg(test)]
+mod test {
+    use super::*;
+
+    fn collect<const N: usize>(args: &VarcallArgs<u32, N>) -> Vec<u32> {
+        (0..args.len())
+            .map(|i| unsafe { **args.as_ptr().add(i) })
+            .collect()
+    }
+
+    #[test]
+    fn inline_up_to_capacity() {
+        let values = [1, 2, 3, 4];
+
+        let args = VarcallArgs::<u32, 4>::new(values.iter().map(|v| v as *const u32));
+        assert!(args.is_inline());
+        assert_eq!(collect(&args), values);
+
+        let empty = VarcallArgs::<u32, 4>::new(std::iter::empty());
+        assert!(empty.is_inline());
+        assert!(empty.is_empty());
+    }
+
+    #[test]
+    fn spills_to_heap() {
+        let values: Vec<u32> = (0..10).collect();
+
+        // Known size upfront.
+        let args = VarcallArgs::<u32, 4>::new(values.iter().map(|v| v as *const u32));
+        assert!(!args.is_inline());
+        assert_eq!(collect(&args), values);
+
+        // Size only discovered while iterating.
+        let filtered = values.iter().filter(|_| true).map(|v| v as *const u32);
+        let args = VarcallArgs::<u32, 4>::new(filtered);
+        assert!(!args.is_inline());
+        assert_eq!(collect(&args), values);
+    }
+}
@@ -20,6 +20,7 @@ pub fn transform(decl: Declaration) -> ParseResult<TokenStream> {
     let fields = parse_fields(class)?;
 
     let base_ty = &struct_cfg.base_ty;
+    let lazy_methods = struct_cfg.lazy_methods;
     let class_name = &class.name;
     let class_name_str = class.name.to_string();
     let inherits_macro = format_ident!("inherits_transitive_{}", base_ty);
@@ -28,6 +29,12 @@ pub fn transform(decl: Declaration) -> ParseResult<TokenStream> {
     let deref_impl = make_deref_impl(class_name, &fields);
 
     let godot_exports_impl = make_exports_impl(class_name, &fields);
+    let properties_plugin = make_properties_plugin(class_name, &fields);
+
+    let storage_policy = struct_cfg.storage_policy.as_ref().map(|policy| {
+        quote! { const STORAGE: ::godot::obj::StoragePolicy = ::godot::obj::StoragePolicy::#policy; }
+    });
+    let storage_assertion = make_storage_assertion(class_name, struct_cfg.storage_policy.as_ref());
 
     let (godot_init_impl, create_fn);
     if struct_cfg.has_generated_init {
@@ -45,8 +52,15 @@ pub fn transform(decl: Declaration) -> ParseResult<TokenStream> {
             type Mem = <Self::Base as ::godot::obj::GodotClass>::Mem;
 
             const CLASS_NAME: &'static str = #class_name_str;
+            #storage_policy
+
+            fn __class_tag() -> ::godot::obj::ClassTag {
+                static CACHE: ::godot::obj::ClassTagCache = ::godot::obj::ClassTagCache::new();
+                CACHE.get::<Self>()
+            }
         }
 
+        #storage_assertion
         #godot_init_impl
         #godot_exports_impl
         #deref_impl
@@ -57,9 +71,12 @@ pub fn transform(decl: Declaration) -> ParseResult<TokenStream> {
                 base_class_name: <::godot::engine::#base_ty as ::godot::obj::GodotClass>::CLASS_NAME,
                 generated_create_fn: #create_fn,
                 free_fn: #prv::callbacks::free::<#class_name>,
+                lazy_methods: #lazy_methods,
             },
         });
 
+        #properties_plugin
+
         #prv::class_macros::#inherits_macro!(#class_name);
     })
 }
@@ -68,6 +85,8 @@ pub fn transform(decl: Declaration) -> ParseResult<TokenStream> {
 fn parse_struct_attributes(class: &Struct) -> ParseResult<ClassAttributes> {
     let mut base_ty = ident("RefCounted");
     let mut has_generated_init = false;
+    let mut storage_policy = None;
+    let mut lazy_methods = false;
 
     // #[func] attribute on struct
     if let Some(mut parser) = KvParser::parse(&class.attributes, "class")? {
@@ -79,12 +98,53 @@ fn parse_struct_attributes(class: &Struct) -> ParseResult<ClassAttributes> {
             has_generated_init = true;
         }
 
+        if parser.handle_alone("lazy_methods")? {
+            lazy_methods = true;
+        }
+
+        if let Some(policy) = parser.handle_lit("storage")? {
+            let policy = match policy.trim_matches('"') {
+                "checked" => ident("Checked"),
+                "sync" => ident("Sync"),
+                "unchecked" => bail(
+                    "#[class(storage = \"unchecked\")] can cause undefined behavior; \
+                    use #[class(unsafe_storage = \"unchecked\")] together with `unsafe impl UncheckedStorage`",
+                    parser.span(),
+                )?,
+                other => bail(
+                    format!("#[class(storage)]: unknown policy \"{other}\", expected \"checked\" or \"sync\""),
+                    parser.span(),
+                )?,
+            };
+            storage_policy = Some(policy);
+        }
+
+        if let Some(policy) = parser.handle_lit("unsafe_storage")? {
+            if storage_policy.is_some() {
+                bail(
+                    "#[class(storage)] and #[class(unsafe_storage)] are mutually exclusive",
+                    parser.span(),
+                )?;
+            }
+
+            let policy = match policy.trim_matches('"') {
+                "unchecked" => ident("Unchecked"),
+                other => bail(
+                    format!("#[class(unsafe_storage)]: unknown policy \"{other}\", expected \"unchecked\""),
+                    parser.span(),
+                )?,
+            };
+            storage_policy = Some(policy);
+        }
+
         parser.finish()?;
     }
 
     Ok(ClassAttributes {
         base_ty,
         has_generated_init,
+        storage_policy,
+        lazy_methods,
     })
 }
 
@@ -151,6 +211,8 @@ fn parse_fields(class: &Struct) -> ParseResult<Fields> {
 struct ClassAttributes {
     base_ty: Ident,
     has_generated_init: bool,
+    storage_policy: Option<Ident>,
+    lazy_methods: bool,
 }
 
 struct Fields {
@@ -242,6 +304,28 @@ fn make_godot_init_impl(class_name: &Ident, fields: Fields) -> TokenStream {
     }
 }
 
+/// Compile-time check of the bounds that a storage policy requires from the class.
+fn make_storage_assertion(class_name: &Ident, storage_policy: Option<&Ident>) -> TokenStream {
+    match storage_policy {
+        // The instance is shared across threads, so `&T` and `&mut T` are handed out on several of them.
+        Some(policy) if policy == "Sync" => quote! {
+            const _: fn() = || {
+                fn assert_send_sync<T: Send + Sync>() {}
+                assert_send_sync::<#class_name>();
+            };
+        },
+
+        // Borrow tracking is skipped, which the user must acknowledge with an `unsafe impl`.
+        Some(policy) if policy == "Unchecked" => quote! {
+            const _: fn() = || {
+                fn assert_unchecked_storage<T: ::godot::obj::UncheckedStorage>() {}
+                assert_unchecked_storage::<#class_name>();
+            };
+        },
+        _ => TokenStream::new(),
+    }
+}
+
 fn make_deref_impl(class_name: &Ident, fields: &Fields) -> TokenStream {
     let base_field = if let Some(Field { name, .. }) = &fields.base_field {
         name
@@ -287,7 +371,7 @@ fn make_exports_impl(class_name: &Ident, fields: &Fields) -> TokenStream {
             quote! {
                 use ::godot::builtin::meta::VariantMetadata;
 
-                let class_name = ::godot::builtin::StringName::from(#class_name::CLASS_NAME);
+                let class_name = ::godot::builtin::static_sname!(#class_name::CLASS_NAME);
                 let property_info = ::godot::builtin::meta::PropertyInfo::new(
                     <#field_type>::variant_type(),
                     ::godot::builtin::meta::ClassName::of::<#class_name>(),
@@ -297,8 +381,8 @@ fn make_exports_impl(class_name: &Ident, fields: &Fields) -> TokenStream {
                 );
                 let property_info_sys = property_info.property_sys();
 
-                let getter_string_name = ::godot::builtin::StringName::from(#getter);
-                let setter_string_name = ::godot::builtin::StringName::from(#setter);
+                let getter_string_name = ::godot::builtin::static_sname!(#getter);
+                let setter_string_name = ::godot::builtin::static_sname!(#setter);
                 unsafe {
                     ::godot::sys::interface_fn!(classdb_register_extension_class_property)(
                         ::godot::sys::get_library(),
@@ -310,6 +394,8 @@ fn make_exports_impl(class_name: &Ident, fields: &Fields) -> TokenStream {
                 }
             }
         });
+    let property_table = make_property_table(class_name, fields);
+
     quote! {
         impl ::godot::obj::cap::ImplementsGodotExports for #class_name {
             fn __register_exports() {
@@ -319,6 +405,69 @@ fn make_exports_impl(class_name: &Ident, fields: &Fields) -> TokenStream {
                     }
                 )*
             }
+
+            #property_table
+        }
+    }
+}
+
+/// Accessors for the `set_func`/`get_func` fast path, which call getter and setter directly instead of through varcall.
+fn make_property_table(class_name: &Ident, fields: &Fields) -> TokenStream {
+    if fields.exported_fields.is_empty() {
+        return TokenStream::new();
+    }
+
+    let accessor_count = fields.exported_fields.len();
+    let accessors = fields.exported_fields.iter().map(|exported_field| {
+        let name = exported_field.field.name.to_string();
+        let getter = format_ident!("{}", exported_field.getter.trim_matches('"'));
+        let setter = format_ident!("{}", exported_field.setter.trim_matches('"'));
+
+        quote! {
+            ::godot::private::PropertyAccessor {
+                name: #name,
+                get: |this: &#class_name| ::godot::builtin::ToVariant::to_variant(&this.#getter()),
+                set: |this: &mut #class_name, value: &::godot::builtin::Variant| {
+                    match ::godot::builtin::FromVariant::try_from_variant(value) {
+                        Ok(value) => {
+                            this.#setter(value);
+                            true
+                        }
+                        Err(_) => false,
+                    }
+                },
+            }
+        }
+    });
+
+    quote! {
+        fn __property_table() -> Option<&'static ::godot::private::PropertyTable<Self>> {
+            static ACCESSORS: [::godot::private::PropertyAccessor<#class_name>; #accessor_count] = [
+                #( #accessors, )*
+            ];
+            static TABLE: ::godot::private::PropertyTable<#class_name> =
+                ::godot::private::PropertyTable::new(&ACCESSORS);
+
+            Some(&TABLE)
         }
     }
+}
+
+fn make_properties_plugin(class_name: &Ident, fields: &Fields) -> TokenStream {
+    if fields.exported_fields.is_empty() {
+        return TokenStream::new();
+    }
+
+    let class_name_str = class_name.to_string();
+    let prv = quote! { ::godot::private };
+
+    quote! {
+        ::godot::sys::plugin_add!(__GODOT_PLUGIN_REGISTRY in #prv; #prv::ClassPlugin {
+            class_name: #class_name_str,
+            component: #prv::PluginComponent::UserProperties {
+                set_fn: #prv::callbacks::set_property::<#class_name>,
+                get_fn: #prv::callbacks::get_property::<#class_name>,
+            },
+        });
+    }
 }
\ No newline at end of file
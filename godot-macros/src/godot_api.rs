@@ -85,10 +85,10 @@ fn transform_inherent_impl(mut decl: Impl) -> Result<TokenStream, Error> {
                 )*
 
                 unsafe {
-                    let class_name = ::godot::builtin::StringName::from(#class_name_str);
+                    let class_name = ::godot::builtin::static_sname!(#class_name_str);
                     use ::godot::sys;
                     #(
-                        let signal_name = ::godot::builtin::StringName::from(#signal_name_strs);
+                        let signal_name = ::godot::builtin::static_sname!(#signal_name_strs);
                         sys::interface_fn!(classdb_register_extension_class_signal)(
                             sys::get_library(),
                             class_name.string_sys(),
@@ -284,15 +284,17 @@ fn transform_trait_impl(original_impl: Impl) -> Result<TokenStream, Error> {
         impl ::godot::private::You_forgot_the_attribute__godot_api for #class_name {}
 
         impl ::godot::obj::cap::ImplementsGodotExt for #class_name {
-            fn __virtual_call(name: &str) -> ::godot::sys::GDExtensionClassCallVirtual {
+            fn __virtual_call(name: &::godot::builtin::StringName) -> ::godot::sys::GDExtensionClassCallVirtual {
                 //println!("virtual_call: {}.{}", std::any::type_name::<Self>(), name);
 
-                match name {
-                    #(
-                       #virtual_method_names => #prv::gdext_virtual_method_callback!(#class_name, #virtual_methods),
-                    )*
-                    _ => None,
-                }
+                // Compare by interned identity against names cached once per class; no allocation or FFI call.
+                #(
+                    if name.is_same_interned(::godot::builtin::static_sname!(#virtual_method_names)) {
+                        return #prv::gdext_virtual_method_callback!(#class_name, #virtual_methods);
+                    }
+                )*
+
+                None
             }
         }
 
@@ -24,7 +24,7 @@ pub fn transform(input_decl: Declaration) -> ParseResult<TokenStream> {
         || func.return_ty.is_some()
         || func.where_clause.is_some()
     {
-        return bad_signature(&func);
+        return bad_signature(&func, "itest");
     }
 
     let mut attr = KvParser::parse_required(&func.attributes, "itest", &func.name)?;
@@ -41,22 +41,10 @@ pub fn transform(input_decl: Declaration) -> ParseResult<TokenStream> {
 
     let test_name = &func.name;
     let test_name_str = func.name.to_string();
-
-    // Detect parameter name chosen by user, or unused fallback
-    let param = if let Some((param, _punct)) = func.params.first() {
-        if let FnParam::Typed(param) = param {
-            // Correct parameter type (crude macro check) -> reuse parameter name
-            if path_ends_with(&param.ty.tokens, "TestContext") {
-                param.to_token_stream()
-            } else {
-                return bad_signature(&func);
-            }
-        } else {
-            return bad_signature(&func);
-        }
-    } else {
+    let param = context_param(&func, "itest")?.unwrap_or_else(|| {
+        // Unused fallback
         quote! { __unused_context: &crate::TestContext }
-    };
+    });
 
     let body = &func.body;
 
@@ -76,14 +64,116 @@ pub fn transform(input_decl: Declaration) -> ParseResult<TokenStream> {
     })
 }
 
-fn bad_signature(func: &Function) -> Result<TokenStream, Error> {
-    bail(
+/// Transforms a `#[bench]` function, which is registered for the benchmark runner instead of the test runner.
+///
+/// The function body is one operation. `#[bench(repeat = N)]` runs it `N` times per timed sample, so that the runner
+/// can report the time per operation. `#[bench(setup = make_fixture)]` calls `make_fixture()` once per sample, outside
+/// the timed section, and passes `&mut` to its result as the last argument of every call.
+pub fn transform_bench(input_decl: Declaration) -> ParseResult<TokenStream> {
+    let func = match input_decl {
+        Declaration::Function(f) => f,
+        _ => return bail("#[bench] can only be applied to functions", &input_decl),
+    };
+
+    if func.generic_params.is_some() || func.params.len() > 2 || func.where_clause.is_some() {
+        return bad_signature(&func, "bench");
+    }
+
+    let mut attr = KvParser::parse_required(&func.attributes, "bench", &func.name)?;
+    let repetitions = match attr.handle_lit("repeat")? {
+        Some(repeat) => match repeat.parse::<usize>() {
+            Ok(repeat) if repeat > 0 => repeat,
+            _ => return bail("#[bench]: `repeat` must be a positive integer", &func.name),
+        },
+        None => 1,
+    };
+    let setup = attr.handle_ident("setup")?;
+    attr.finish()?;
+
+    let bench_name = &func.name;
+    let bench_name_str = func.name.to_string();
+    let ret = func.return_ty.as_ref().map(|ty| quote! { -> #ty });
+    let body = &func.body;
+
+    // Parameters: optional `&TestContext`, then the fixture if there is a setup function.
+    let has_ctx = matches!(
+        func.params.first(),
+        Some((FnParam::Typed(param), _)) if path_ends_with(&param.ty.tokens, "TestContext")
+    );
+    let fixture_count = func.params.len() - has_ctx as usize;
+    if fixture_count != setup.is_some() as usize {
+        return bad_signature(&func, "bench");
+    }
+
+    let params = func.params.inner.iter().map(|(param, _punct)| param);
+    let mut args = Vec::new();
+    if has_ctx {
+        args.push(quote! { __ctx });
+    }
+
+    let make_fixture = setup.map(|setup| {
+        args.push(quote! { &mut __fixture });
+        quote! { let mut __fixture = #setup(); }
+    });
+
+    Ok(quote! {
+        pub fn #bench_name(#(#params),*) #ret {
+            #body
+        }
+
+        ::godot::sys::plugin_add!(__GODOT_BENCH in crate; crate::RustBenchmark {
+            name: #bench_name_str,
+            file: std::file!(),
+            line: std::line!(),
+            repetitions: #repetitions,
+            function: |__ctx: &crate::TestContext| {
+                #make_fixture
+
+                let __clock = std::time::Instant::now();
+                for _ in 0..#repetitions {
+                    // Pass the result on, so the benchmarked code cannot be optimized away.
+                    crate::bench_used(#bench_name(#(#args),*));
+                }
+                __clock.elapsed()
+            },
+        });
+    })
+}
+
+/// Returns the `&TestContext` parameter if declared, reusing the name chosen by the user.
+fn context_param(func: &Function, attr_name: &str) -> ParseResult<Option<TokenStream>> {
+    let param = match func.params.first() {
+        Some((param, _punct)) => param,
+        None => return Ok(None),
+    };
+
+    match param {
+        // Correct parameter type (crude macro check) -> reuse parameter name
+        FnParam::Typed(param) if path_ends_with(&param.ty.tokens, "TestContext") => {
+            Ok(Some(param.to_token_stream()))
+        }
+        _ => bad_signature(func, attr_name),
+    }
+}
+
+fn bad_signature<R>(func: &Function, attr_name: &str) -> Result<R, Error> {
+    let message = if attr_name == "bench" {
+        format!(
+            "#[bench] function must have one of these signatures:\
+                \n  fn {f}() -> T {{ ... }}\
+                \n  fn {f}(ctx: &TestContext) -> T {{ ... }}\
+                \nWith #[bench(setup = make_fixture)], a last parameter of type `&F` or `&mut F` is required, \
+                where `make_fixture: fn() -> F`.",
+            f = func.name
+        )
+    } else {
         format!(
-            "#[itest] function must have one of these signatures:\
+            "#[{attr_name}] function must have one of these signatures:\
                 \n  fn {f}() {{ ... }}\
                 \n  fn {f}(ctx: &TestContext) {{ ... }}",
             f = func.name
-        ),
-        func,
-    )
-}
\ No newline at end of file
+        )
+    };
+
+    bail(message, func)
+}
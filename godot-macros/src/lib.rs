@@ -17,6 +17,12 @@ mod godot_api;
 mod itest;
 mod util;
 
+/// Derives `GodotClass` and registers the struct as a Godot class.
+///
+/// `#[class(lazy_methods)]` defers registration of `#[func]` methods, `#[export]` properties and the user
+/// `register_class()` until the first instance of the class is created. Until then, these symbols are invisible to
+/// `ClassDB`, the editor and GDScript static typing: typed GDScript that calls them may fail to compile, and the
+/// inspector shows no exported properties. Only use it for classes that are instantiated before they are used by name.
 #[proc_macro_derive(GodotClass, attributes(class, property, export, base, signal))]
 pub fn derive_native_class(input: TokenStream) -> TokenStream {
     translate(input, derive_godot_class::transform)
@@ -35,6 +41,15 @@ pub fn itest(meta: TokenStream, input: TokenStream) -> TokenStream {
     translate_meta("itest", meta, input, itest::transform)
 }
 
+/// Similar to `#[bench]` on nightly, but runs a benchmark inside Godot; see `itest::transform_bench()`.
+///
+/// Usage: `#[bench]`, `#[bench(repeat = N)]` or `#[bench(repeat = N, setup = make_fixture)]` on a function with an
+/// optional `&TestContext` parameter, followed by the fixture parameter if `setup` is given.
+#[proc_macro_attribute]
+pub fn bench(meta: TokenStream, input: TokenStream) -> TokenStream {
+    translate_meta("bench", meta, input, itest::transform_bench)
+}
+
 /// Proc-macro attribute to be used in combination with the [`ExtensionLibrary`] trait.
 ///
 /// [`ExtensionLibrary`]: crate::init::ExtensionLibrary
@@ -98,7 +98,14 @@
 //! threads.
 
 #[doc(inline)]
-pub use godot_core::{builtin, engine, log, obj, sys};
+pub use godot_core::{arena, builtin, dataset, deferred, engine, log, obj, sys};
+
+#[cfg(feature = "instrument")]
+pub use godot_core::instrument;
+
+/// Re-export of the [rayon](https://docs.rs/rayon) crate, for the parallel iterators on packed arrays.
+#[cfg(feature = "rayon")]
+pub use godot_core::rayon;
 
 /// Facilities for initializing and terminating the GDExtension library.
 pub mod init {
@@ -119,7 +126,7 @@ pub mod bind {
 /// Testing facilities (unstable).
 #[doc(hidden)]
 pub mod test {
-    pub use godot_macros::itest;
+    pub use godot_macros::{bench, itest};
 }
 
 #[doc(hidden)]
@@ -135,8 +142,8 @@ pub mod prelude {
         Node3D, Object, PackedScene, RefCounted, Resource, SceneTree,
     };
     pub use super::init::{gdextension, ExtensionLayer, ExtensionLibrary, InitHandle, InitLevel};
-    pub use super::log::*;
-    pub use super::obj::{Base, Gd, GdMut, GdRef, GodotClass, Inherits, InstanceId, Share};
+    pub use super::log::{godot_error, godot_print, godot_script_error, godot_warn, print};
+    pub use super::obj::{Base, Gd, GdMut, GdRef, GdView, GodotClass, Inherits, InstanceId, Share};
 
     // Make trait methods available
     pub use super::engine::NodeExt as _;
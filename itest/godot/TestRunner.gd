@@ -6,11 +6,20 @@ extends Node
 
 func _ready():
 	var allow_focus := true
+	var run_benchmarks := false
+	var bench_json_path := ""
 	var unrecognized_args: Array = []
 	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--bench-json="):
+			run_benchmarks = true
+			bench_json_path = arg.trim_prefix("--bench-json=")
+			continue
+
 		match arg:
 			"--disallow-focus":
 				allow_focus = false
+			"--bench":
+				run_benchmarks = true
 			_:
 				unrecognized_args.push_back(arg)
 
@@ -21,6 +30,12 @@ func _ready():
 
 	var rust_runner = IntegrationTests.new()
 
+	# Benchmarks run instead of tests: they are slower, and their timings are distorted by test side effects.
+	if run_benchmarks:
+		var bench_success: bool = rust_runner.run_all_benchmarks(self, bench_json_path)
+		get_tree().quit(0 if bench_success else 1)
+		return
+
 	var gdscript_suites: Array = [
 		preload("res://ManualFfiTests.gd").new(),
 		preload("res://gen/GenFfiTests.gd").new(),
@@ -0,0 +1,30 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use crate::itest;
+use godot::arena::{Arena, ArenaBacking};
+use godot::prelude::*;
+
+#[itest]
+fn arena_godot_allocator() {
+    let mut arena = Arena::with_godot_allocator();
+    assert_eq!(arena.backing(), ArenaBacking::Godot);
+
+    {
+        let mut variants = arena.vec();
+        variants.extend((0..100).map(|i: i64| i.to_variant()));
+        let name = arena.alloc(GodotString::from("arena"));
+
+        assert_eq!(variants.len(), 100);
+        assert_eq!(variants[42], 42.to_variant());
+        assert_eq!(name.to_string(), "arena");
+    }
+
+    let reserved = arena.reserved_bytes();
+    arena.reset();
+    assert_eq!(arena.used_bytes(), 0);
+    assert!(arena.reserved_bytes() <= reserved);
+}
@@ -80,6 +80,27 @@ fn array_try_into_vec() {
     assert_eq!(result, Ok(vec![1, 2]));
 }
 
+#[itest]
+fn array_to_vec() {
+    let array = Array::<i64>::from_iter(0..1000);
+    let vec = array.to_vec();
+    assert_eq!(vec, (0..1000).collect::<Vec<i64>>());
+
+    let empty = Array::<i64>::new();
+    assert_eq!(empty.to_vec(), Vec::<i64>::new());
+    assert_eq!(Vec::<i64>::from(&empty), Vec::<i64>::new());
+}
+
+#[itest]
+fn array_as_variant_slice() {
+    let array = array![1, 2, 3];
+    let slice = unsafe { array.as_variant_slice() };
+    assert_eq!(slice, &[1.to_variant(), 2.to_variant(), 3.to_variant()]);
+
+    let empty = VariantArray::new();
+    assert!(unsafe { empty.as_variant_slice() }.is_empty());
+}
+
 #[itest]
 fn array_iter_shared() {
     let array = array![1, 2];
@@ -281,6 +302,20 @@ fn array_extend() {
     assert_eq!(array, array![1, 2, 3, 4]);
 }
 
+#[itest]
+fn array_extend_from_slice() {
+    let mut array = array![1, 2];
+    array.extend_from_slice(&[3, 4, 5]);
+    array.extend_from_slice(&[]);
+    assert_eq!(array, array![1, 2, 3, 4, 5]);
+
+    let mut strings = Array::<GodotString>::new();
+    strings.extend_from_slice(&["a".into(), "b".into()]);
+    strings.extend((0..3).map(|i| GodotString::from(format!("{i}"))));
+    assert_eq!(strings.len(), 5);
+    assert_eq!(strings.get(4), GodotString::from("2"));
+}
+
 #[itest]
 fn array_sort() {
     let mut array = array![2, 1];
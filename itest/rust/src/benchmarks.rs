@@ -0,0 +1,155 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+// Benchmarks for FFI overhead, run with `--bench` or `--bench-json=<path>` (see TestRunner.gd).
+// Each body is one operation, run `repeat` times per sample. Fixtures come from `setup` functions and are not timed.
+
+use godot::bind::{godot_api, GodotClass};
+use godot::builtin::{
+    Array, Dictionary, PackedInt64Array, StringName, ToVariant, Variant, VariantArray,
+};
+use godot::engine::Object;
+use godot::obj::Gd;
+use godot::test::bench;
+
+use crate::TestContext;
+
+/// Number of elements in container fixtures.
+const FIXTURE_LEN: usize = 100;
+
+#[bench(repeat = 100)]
+fn engine_ptrcall(ctx: &TestContext) -> i64 {
+    ctx.scene_tree.get_child_count(false)
+}
+
+#[bench(repeat = 100, setup = varcall_fixture)]
+fn user_varcall(fixture: &(Variant, StringName)) -> i64 {
+    let (variant, method) = fixture;
+    variant.call(method.clone(), &[]).to::<i64>()
+}
+
+#[bench(repeat = 100, setup = property_fixture)]
+fn property_set_get(fixture: &mut (Gd<Object>, StringName)) -> i64 {
+    let (object, property) = fixture;
+    object.set(property.clone(), 7.to_variant());
+    object.get(property.clone()).to::<i64>()
+}
+
+#[bench(repeat = 100, setup = payload)]
+fn gd_bind(obj: &Gd<BenchPayload>) -> i64 {
+    obj.bind().value
+}
+
+#[bench(repeat = 100, setup = payload)]
+fn gd_bind_mut(obj: &mut Gd<BenchPayload>) -> i64 {
+    let mut guard = obj.bind_mut();
+    guard.value += 1;
+    guard.value
+}
+
+#[bench(repeat = 100)]
+fn string_name_from_str() -> StringName {
+    StringName::from("bench_string_name")
+}
+
+#[bench(repeat = 100)]
+fn variant_conversion() -> i64 {
+    7.to_variant().to::<i64>()
+}
+
+#[bench(repeat = 100, setup = empty_array)]
+fn array_push(array: &mut VariantArray) {
+    array.push(7.to_variant());
+}
+
+#[bench(repeat = 100, setup = int_array)]
+fn array_get(array: &Array<i64>) -> i64 {
+    array.get(FIXTURE_LEN / 2)
+}
+
+#[bench(repeat = 100, setup = empty_packed_array)]
+fn packed_array_push(array: &mut PackedInt64Array) {
+    array.push(7);
+}
+
+#[bench(repeat = 100, setup = packed_int_array)]
+fn packed_array_get(array: &PackedInt64Array) -> i64 {
+    array.get(FIXTURE_LEN / 2)
+}
+
+/// One operation iterates over all `FIXTURE_LEN` entries.
+#[bench(repeat = 10, setup = int_dictionary)]
+fn dictionary_iter(dict: &Dictionary) -> i64 {
+    let mut sum = 0;
+    for (_key, value) in dict.iter_shared() {
+        sum += value.to::<i64>();
+    }
+    sum
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+// Fixtures
+
+fn payload() -> Gd<BenchPayload> {
+    Gd::new(BenchPayload { value: 7 })
+}
+
+fn varcall_fixture() -> (Variant, StringName) {
+    (payload().to_variant(), StringName::from("get_value"))
+}
+
+fn property_fixture() -> (Gd<Object>, StringName) {
+    (payload().upcast::<Object>(), StringName::from("value"))
+}
+
+fn empty_array() -> VariantArray {
+    VariantArray::new()
+}
+
+fn empty_packed_array() -> PackedInt64Array {
+    PackedInt64Array::new()
+}
+
+fn int_array() -> Array<i64> {
+    Array::from_iter(0..FIXTURE_LEN as i64)
+}
+
+fn packed_int_array() -> PackedInt64Array {
+    let mut array = PackedInt64Array::new();
+    for i in 0..FIXTURE_LEN as i64 {
+        array.push(i);
+    }
+    array
+}
+
+fn int_dictionary() -> Dictionary {
+    let mut dict = Dictionary::new();
+    for i in 0..FIXTURE_LEN as i64 {
+        dict.insert(i, i);
+    }
+    dict
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[derive(GodotClass, Debug)]
+pub struct BenchPayload {
+    #[export(getter = "get_value", setter = "set_value")]
+    value: i64,
+}
+
+#[godot_api]
+impl BenchPayload {
+    #[func]
+    fn get_value(&self) -> i64 {
+        self.value
+    }
+
+    #[func]
+    fn set_value(&mut self, value: i64) {
+        self.value = value;
+    }
+}
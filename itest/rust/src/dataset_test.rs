@@ -0,0 +1,64 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use crate::itest;
+use godot::dataset::{Dataset, DatasetError, DatasetWriter};
+use godot::prelude::*;
+
+fn write_sample() -> std::path::PathBuf {
+    let path = std::env::temp_dir().join(format!("gdext_dataset_{}.gdxd", std::process::id()));
+
+    let heights: Vec<f32> = (0..1000).map(|i| i as f32 * 0.5).collect();
+    DatasetWriter::new()
+        .add("heights", &heights)
+        .add("cells", &[Vector2::new(1.0, 2.0), Vector2::new(-3.0, 4.5)])
+        .add("flags", &[1u8, 0, 1])
+        .write_to(&path)
+        .expect("write dataset");
+
+    path
+}
+
+#[itest]
+fn dataset_packed_arrays() {
+    let path = write_sample();
+    let dataset = Dataset::open(&path).expect("open dataset");
+
+    let heights = dataset.packed_array::<f32>("heights").unwrap();
+    assert_eq!(heights.len(), 1000);
+    assert_eq!(heights.get(999), 499.5);
+    assert_eq!(heights.as_slice(), dataset.slice::<f32>("heights").unwrap());
+
+    let cells: PackedVector2Array = dataset.packed_array("cells").unwrap();
+    assert_eq!(cells.get(1), Vector2::new(-3.0, 4.5));
+
+    let flags: Array<u8> = dataset.array("flags").unwrap();
+    assert_eq!(flags.len(), 3);
+    assert_eq!(flags.get(0), 1);
+
+    assert!(matches!(
+        dataset.packed_array::<i32>("heights"),
+        Err(DatasetError::TypeMismatch { .. })
+    ));
+
+    drop(dataset);
+    std::fs::remove_file(path).ok();
+}
+
+#[itest]
+fn dataset_to_dictionary() {
+    let path = write_sample();
+    // SAFETY: the file is not modified until the dataset is dropped.
+    let dict = unsafe { Dataset::open_mapped(&path) }
+        .unwrap()
+        .to_dictionary();
+
+    assert_eq!(dict.len(), 3);
+    let flags = dict.get("flags").unwrap().to::<PackedByteArray>();
+    assert_eq!(flags.as_slice(), &[1, 0, 1]);
+
+    std::fs::remove_file(path).ok();
+}
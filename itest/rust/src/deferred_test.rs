@@ -0,0 +1,128 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+use std::future::Future;
+use std::pin::Pin;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::Arc;
+use std::task::{Context, Poll, Wake, Waker};
+
+use godot::builtin::{GodotString, ToVariant, VariantArray, Vector3};
+use godot::deferred::{CommandBuffer, FlushStats, SignalFuture};
+use godot::engine::{Node3D, Object};
+use godot::obj::Gd;
+
+use crate::itest;
+
+#[itest]
+fn command_buffer_flush() {
+    static BUFFER: CommandBuffer = CommandBuffer::new();
+
+    let node = Node3D::new_alloc();
+    let id = node.instance_id();
+
+    // Record from a worker thread; only the instance ID crosses the thread boundary.
+    std::thread::spawn(move || {
+        BUFFER.record(id, |mut node: Gd<Node3D>| {
+            node.set_position(Vector3::new(1.0, 2.0, 3.0));
+        });
+    })
+    .join()
+    .unwrap();
+
+    assert_eq!(BUFFER.len(), 1);
+    assert_eq!(node.get_position(), Vector3::ZERO);
+
+    let stats = BUFFER.flush();
+    assert_eq!(
+        stats,
+        FlushStats {
+            executed: 1,
+            skipped: 0,
+            panicked: 0,
+        }
+    );
+    assert_eq!(node.get_position(), Vector3::new(1.0, 2.0, 3.0));
+    assert!(BUFFER.is_empty());
+
+    node.free();
+}
+
+#[itest]
+fn command_buffer_skips_dead_objects() {
+    let buffer = CommandBuffer::new();
+
+    let node = Node3D::new_alloc();
+    buffer.record(node.instance_id(), |_node: Gd<Node3D>| {
+        panic!("command must not run on freed object");
+    });
+    node.free();
+
+    assert_eq!(buffer.flush().skipped, 1);
+}
+
+#[itest]
+fn command_buffer_continues_after_panic() {
+    let buffer = CommandBuffer::new();
+
+    let node = Node3D::new_alloc();
+    buffer.record(node.instance_id(), |_node: Gd<Node3D>| {
+        panic!("expected panic in flushed command");
+    });
+    buffer.record(node.instance_id(), |mut node: Gd<Node3D>| {
+        node.set_position(Vector3::new(4.0, 5.0, 6.0));
+    });
+
+    let stats = buffer.flush();
+    assert_eq!(stats.panicked, 1);
+    assert_eq!(stats.executed, 1);
+    assert_eq!(node.get_position(), Vector3::new(4.0, 5.0, 6.0));
+
+    node.free();
+}
+
+#[itest]
+fn signal_future_resolves() {
+    let mut obj = Object::new_alloc();
+    obj.add_user_signal(GodotString::from("custom"), VariantArray::new());
+
+    let mut future = SignalFuture::new(&obj, "custom");
+    assert_eq!(future.try_take(), None);
+
+    obj.emit_signal("custom".into(), &[7.to_variant(), "text".to_variant()]);
+    assert_eq!(
+        future.try_take(),
+        Some(vec![7.to_variant(), "text".to_variant()])
+    );
+
+    obj.free();
+}
+
+#[itest]
+fn signal_future_wakes() {
+    struct Flag(AtomicBool);
+    impl Wake for Flag {
+        fn wake(self: Arc<Self>) {
+            self.0.store(true, Ordering::SeqCst);
+        }
+    }
+
+    let mut obj = Object::new_alloc();
+    obj.add_user_signal(GodotString::from("custom"), VariantArray::new());
+
+    let flag = Arc::new(Flag(AtomicBool::new(false)));
+    let waker = Waker::from(Arc::clone(&flag));
+    let mut cx = Context::from_waker(&waker);
+
+    let mut future = SignalFuture::new(&obj, "custom");
+    assert!(Pin::new(&mut future).poll(&mut cx).is_pending());
+
+    obj.emit_signal("custom".into(), &[]);
+    assert!(flag.0.load(Ordering::SeqCst));
+    assert_eq!(Pin::new(&mut future).poll(&mut cx), Poll::Ready(vec![]));
+
+    obj.free();
+}
@@ -7,7 +7,9 @@
 use std::collections::{HashMap, HashSet};
 
 use crate::{expect_panic, itest};
-use godot::builtin::{dict, varray, Dictionary, FromVariant, ToVariant, Variant};
+use godot::builtin::{
+    dict, varray, Dictionary, FromVariant, GodotString, ToVariant, TypedDictionary, Variant,
+};
 use godot::obj::Share;
 
 #[itest]
@@ -362,6 +364,55 @@ fn dictionary_iter_equals_big() {
     assert_eq!(dictionary, collected_dictionary);
 }
 
+#[itest]
+fn dictionary_iter_typed_chunks() {
+    // Spans several chunks, with a partial one at the end.
+    let dictionary: Dictionary = (0..150).zip(1000..1150).collect();
+    let mut iter = dictionary.iter_shared().typed::<i64, i64>();
+    assert_eq!(iter.size_hint(), (150, Some(150)));
+
+    let pairs: Vec<(i64, i64)> = iter.by_ref().take(70).collect();
+    assert_eq!(pairs, (0..70).zip(1000..1070).collect::<Vec<_>>());
+    assert_eq!(iter.size_hint(), (80, Some(80)));
+
+    let rest: Vec<(i64, i64)> = iter.collect();
+    assert_eq!(rest, (70..150).zip(1070..1150).collect::<Vec<_>>());
+}
+
+#[itest]
+fn dictionary_to_pairs() {
+    let dictionary = dict! {
+        "foo": 0,
+        "bar": true,
+    };
+
+    let pairs = dictionary.to_pairs();
+    assert_eq!(
+        pairs,
+        vec![
+            ("foo".to_variant(), 0.to_variant()),
+            ("bar".to_variant(), true.to_variant()),
+        ]
+    );
+    assert!(Dictionary::new().to_pairs().is_empty());
+}
+
+#[itest]
+fn dictionary_for_each() {
+    let dictionary: Dictionary = (0..1000).zip(0..1000).collect();
+
+    let mut sum = 0;
+    let mut count = 0;
+    dictionary.for_each(|key, value| {
+        assert_eq!(key, value);
+        sum += i64::from_variant(value);
+        count += 1;
+    });
+
+    assert_eq!(count, 1000);
+    assert_eq!(sum, (0..1000).sum::<i64>());
+}
+
 // Insertion mid-iteration seems to work and is not explicitly forbidden in the docs:
 // https://docs.godotengine.org/en/latest/classes/class_dictionary.html#description
 
@@ -584,3 +635,46 @@ fn dictionary_iter_erase() {
     ```
      */
 }
+
+#[itest]
+fn typed_dictionary_get_insert_remove() {
+    let mut dict = TypedDictionary::<i64, GodotString>::new();
+    assert!(dict.is_empty());
+
+    assert_eq!(dict.insert(1, "one".into()), None);
+    assert_eq!(dict.insert(1, "uno".into()), Some("one".into()));
+    dict.set(2, "two".into());
+
+    assert_eq!(dict.len(), 2);
+    assert_eq!(dict.get(&1), Some("uno".into()));
+    assert_eq!(dict.get(&3), None);
+    assert!(dict.contains_key(&2));
+
+    assert_eq!(dict.remove(&2), Some("two".into()));
+    assert_eq!(dict.remove(&2), None);
+    assert_eq!(dict.to_pairs(), vec![(1, GodotString::from("uno"))]);
+}
+
+#[itest]
+fn typed_dictionary_iter() {
+    let dict: TypedDictionary<i64, i64> = (0..100).map(|i| (i, i * i)).collect();
+
+    let map: HashMap<i64, i64> = dict.iter_shared().collect();
+    assert_eq!(map, (0..100).map(|i| (i, i * i)).collect());
+
+    let keys: HashSet<i64> = dict.keys_shared().collect();
+    assert_eq!(keys, (0..100).collect());
+}
+
+#[itest]
+fn typed_dictionary_from_to_variant() {
+    let untyped = dict! { 1: 10, 2: 20 };
+    let variant = untyped.to_variant();
+
+    let typed = TypedDictionary::<i64, i64>::try_from_variant(&variant).expect("matching types");
+    assert_eq!(typed.get(&2), Some(20));
+    assert_eq!(typed.to_variant(), variant);
+
+    let mismatched = TypedDictionary::<i64, GodotString>::try_from_variant(&variant);
+    assert!(mismatched.is_err());
+}
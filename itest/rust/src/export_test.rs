@@ -4,9 +4,42 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+use crate::itest;
+use godot::obj::cap::ImplementsGodotExports;
 use godot::{engine::Texture, prelude::*};
 
-// No tests currently, tests using HasProperty are in Godot scripts.
+// Further tests using HasProperty are in Godot scripts.
+
+#[itest]
+fn export_property_table() {
+    let table = HasProperty::__property_table().expect("class has exports");
+
+    let accessor = table.find(&StringName::from("int_val")).unwrap();
+    assert_eq!(accessor.name, "int_val");
+    assert!(table.find(&StringName::from("texture_val")).is_some());
+    assert!(table.find(&StringName::from("base")).is_none());
+    assert!(table.find(&StringName::from("unknown")).is_none());
+}
+
+#[itest]
+fn export_object_set_get() {
+    let obj = Gd::<HasProperty>::new_default();
+    let mut node = obj.share().upcast::<Node>();
+
+    // Goes through the class's set_func/get_func, i.e. the Rust setter and getter.
+    node.set("int_val".into(), 42.to_variant());
+    assert_eq!(obj.bind().int_val, 42);
+    assert_eq!(node.get("int_val".into()), 42.to_variant());
+
+    node.set("string_val".into(), "text".to_variant());
+    assert_eq!(obj.bind().string_val, GodotString::from("text"));
+
+    // Properties of the base class are not in the table and still take the regular path.
+    node.set("name".into(), "Renamed".to_variant());
+    assert_eq!(node.get_name(), StringName::from("Renamed"));
+
+    node.free();
+}
 
 #[derive(GodotClass)]
 #[class(base=Node)]
@@ -9,13 +9,18 @@ use godot::engine::Node;
 use godot::init::{gdextension, ExtensionLibrary};
 use godot::obj::Gd;
 use godot::sys;
+use std::time::Duration;
 
+mod arena_test;
 mod array_test;
 mod base_test;
 mod basis_test;
+mod benchmarks;
 mod builtin_test;
 mod codegen_test;
 mod color_test;
+mod dataset_test;
+mod deferred_test;
 mod dictionary_test;
 mod enum_test;
 mod export_test;
@@ -62,8 +67,9 @@ pub(crate) fn expect_panic(context: &str, code: impl FnOnce() + std::panic::Unwi
 #[gdextension(entry_point=itest_init)]
 unsafe impl ExtensionLibrary for runner::IntegrationTests {}
 
-// Registers all the `#[itest]` tests.
+// Registers all the `#[itest]` tests and `#[bench]` benchmarks.
 sys::plugin_registry!(__GODOT_ITEST: RustTestCase);
+sys::plugin_registry!(__GODOT_BENCH: RustBenchmark);
 
 /// Finds all `#[itest]` tests.
 fn collect_rust_tests() -> (Vec<RustTestCase>, usize, bool) {
@@ -92,6 +98,33 @@ fn collect_rust_tests() -> (Vec<RustTestCase>, usize, bool) {
     (tests, all_files.len(), is_focus_run)
 }
 
+/// Finds all `#[bench]` benchmarks.
+fn collect_rust_benchmarks() -> (Vec<RustBenchmark>, usize) {
+    let mut all_files = std::collections::HashSet::new();
+    let mut benchmarks: Vec<RustBenchmark> = vec![];
+
+    sys::plugin_foreach!(__GODOT_BENCH; |bench: &RustBenchmark| {
+        all_files.insert(bench.file);
+        benchmarks.push(*bench);
+    });
+
+    // Sort for deterministic run order
+    benchmarks.sort_by_key(|bench| (bench.file, bench.line));
+
+    (benchmarks, all_files.len())
+}
+
+/// Keeps a benchmark result alive, so the code computing it cannot be optimized away.
+///
+/// Like `std::hint::black_box()`, which is not available with the MSRV.
+pub(crate) fn bench_used<T>(value: T) {
+    let value = std::mem::ManuallyDrop::new(value);
+
+    // SAFETY: reads a valid value; the original is never dropped, so the copy is dropped exactly once.
+    let value = unsafe { std::ptr::read_volatile(&*value as *const T) };
+    drop(value);
+}
+
 pub struct TestContext {
     scene_tree: Gd<Node>,
 }
@@ -106,4 +139,15 @@ struct RustTestCase {
     #[allow(dead_code)]
     line: u32,
     function: fn(&TestContext),
+}
+
+#[derive(Copy, Clone)]
+struct RustBenchmark {
+    name: &'static str,
+    file: &'static str,
+    line: u32,
+    /// Number of operations performed by one call of `function`.
+    repetitions: usize,
+    /// Sets up and runs one sample; returns the time taken by the operations, without setup.
+    function: fn(&TestContext) -> Duration,
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 use std::cell::RefCell;
 use std::mem;
 use std::rc::Rc;
+use std::sync::{Arc, Barrier};
 
 use godot::bind::{godot_api, GodotClass, GodotExt};
 use godot::builtin::{
@@ -14,8 +15,8 @@ use godot::builtin::{
 };
 use godot::engine::node::InternalMode;
 use godot::engine::{file_access, Area2D, Camera3D, FileAccess, Node, Node3D, Object, RefCounted};
-use godot::obj::{Base, Gd, InstanceId};
-use godot::obj::{Inherits, Share};
+use godot::obj::{Base, ClassTag, Gd, GodotClass, InstanceId};
+use godot::obj::{Inherits, Share, UncheckedStorage};
 use godot::sys::GodotFfi;
 
 use crate::{expect_panic, itest, TestContext};
@@ -161,6 +162,43 @@ fn object_instance_id_when_freed() {
     });
 }
 
+#[itest]
+fn object_instance_id_cached_on_share() {
+    let node: Gd<Node3D> = Node3D::new_alloc();
+    let id = node.instance_id();
+
+    let shared = node.share();
+    assert_eq!(shared.instance_id(), id);
+
+    node.free();
+    assert!(!shared.is_instance_valid());
+    assert_eq!(shared.instance_id_or_none(), None);
+}
+
+#[itest]
+fn object_view_refcount() {
+    let obj = RefCounted::new();
+    assert_eq!(obj.get_reference_count(), 1);
+
+    {
+        let view = obj.view();
+        assert_eq!(view.get_reference_count(), 1);
+        assert_eq!(view.instance_id(), obj.instance_id());
+        assert!(view.can_translate_messages());
+
+        let owned = view.share();
+        assert_eq!(owned.get_reference_count(), 2);
+    }
+    assert_eq!(obj.get_reference_count(), 1);
+
+    // Views can be collected and dropped in bulk, without releasing references. Assigning through a view does not
+    // compile (see the GdView docs), so the only way to change the count is share().
+    let views: Vec<_> = (0..10).map(|_| obj.view()).collect();
+    assert_eq!(obj.get_reference_count(), 1);
+    drop(views);
+    assert_eq!(obj.get_reference_count(), 1);
+}
+
 #[itest]
 fn object_from_invalid_instance_id() {
     let id = InstanceId::try_from_i64(0xDEADBEEF).unwrap();
@@ -434,6 +472,30 @@ fn object_engine_bad_downcast() {
     free_ref.free();
 }
 
+#[itest]
+fn object_class_tag_cached() {
+    let cached = Node3D::__class_tag();
+    assert!(!cached.is_null());
+    assert_eq!(cached, ClassTag::lookup::<Node3D>());
+    assert_eq!(Node3D::__class_tag(), cached);
+
+    assert_ne!(Node::__class_tag(), cached);
+    assert_eq!(ObjPayload::__class_tag(), ClassTag::lookup::<ObjPayload>());
+}
+
+#[itest]
+fn object_engine_upcast_refcount() {
+    let obj = RefCounted::new();
+    let id = obj.instance_id();
+
+    let object = obj.share().upcast::<Object>();
+    assert_eq!(object.instance_id(), id);
+    assert_eq!(obj.get_reference_count(), 2);
+
+    drop(object);
+    assert_eq!(obj.get_reference_count(), 1);
+}
+
 #[itest]
 fn object_engine_accept_polymorphic() {
     let mut node = Camera3D::new_alloc();
@@ -619,6 +681,127 @@ fn object_get_scene_tree(ctx: &TestContext) {
     assert_eq!(count, 1);
 } // implicitly tested: node does not leak
 
+#[itest]
+fn object_user_func_unchecked_storage() {
+    let obj = Gd::new(UncheckedPayload { value: 5 });
+    let mut object = obj.share().upcast::<Object>();
+
+    object.call(StringName::from("set_value"), &[7.to_variant()]);
+    let value = object.call(StringName::from("get_value"), &[]);
+
+    assert_eq!(value, 7.to_variant());
+    assert_eq!(obj.bind().value, 7);
+}
+
+#[itest]
+fn object_user_func_varcall_return() {
+    let obj = Gd::new(UncheckedPayload { value: 5 });
+    let mut object = obj.upcast::<Object>();
+
+    let echoed = object.call(
+        StringName::from("echo"),
+        &[GodotString::from("hi").to_variant()],
+    );
+    assert_eq!(echoed, GodotString::from("hi").to_variant());
+
+    let unit = object.call(StringName::from("set_value"), &[(-3).to_variant()]);
+    assert_eq!(unit, Variant::nil());
+
+    let value = object.call(StringName::from("get_value"), &[]);
+    assert_eq!(value, (-3).to_variant());
+}
+
+#[itest]
+fn object_user_func_sync_storage() {
+    let mut obj = Gd::new(SyncPayload { value: 5 });
+    let mut object = obj.share().upcast::<Object>();
+
+    object.call(StringName::from("set_value"), &[7.to_variant()]);
+    let value = object.call(StringName::from("get_value"), &[]);
+    assert_eq!(value, 7.to_variant());
+
+    // Multiple shared guards may coexist, like with RefCell.
+    {
+        let first = obj.bind();
+        let second = obj.bind();
+        assert_eq!(first.value, second.value);
+    }
+
+    obj.bind_mut().value = 9;
+    assert_eq!(obj.bind().value, 9);
+}
+
+#[itest]
+fn object_user_func_sync_storage_threads() {
+    const THREADS: usize = 4;
+    const ITERATIONS: i32 = 500;
+
+    let obj = Gd::new(SyncPayload { value: 0 });
+    let id = obj.instance_id();
+    let start = Arc::new(Barrier::new(THREADS));
+
+    // Only the ID crosses threads; each thread looks up its own Gd and binds concurrently with the others.
+    let threads: Vec<_> = (0..THREADS)
+        .map(|_| {
+            let start = Arc::clone(&start);
+            std::thread::spawn(move || {
+                let mut obj = Gd::<SyncPayload>::try_from_instance_id(id).expect("object alive");
+                start.wait();
+
+                for _ in 0..ITERATIONS {
+                    {
+                        // Two separate steps: a reader seeing an odd value would mean the write lock was not exclusive.
+                        let mut guard = obj.bind_mut();
+                        guard.value += 1;
+                        std::thread::yield_now();
+                        guard.value += 1;
+                    }
+
+                    let value = obj.bind().value;
+                    assert_eq!(value % 2, 0, "observed partial write");
+                }
+            })
+        })
+        .collect();
+
+    for thread in threads {
+        thread.join().expect("thread panicked");
+    }
+
+    assert_eq!(obj.bind().value, 2 * ITERATIONS * THREADS as i32);
+}
+
+#[itest]
+fn object_user_func_sync_storage_poisoned() {
+    let mut obj = Gd::new(SyncPayload { value: 1 });
+    let id = obj.instance_id();
+
+    // A panic while the write lock is held poisons it; later binds still succeed (see recover_poisoned()).
+    let result = std::thread::spawn(move || {
+        let mut obj = Gd::<SyncPayload>::try_from_instance_id(id).expect("object alive");
+        let mut guard = obj.bind_mut();
+        guard.value = 2;
+        panic!("expected panic while bound");
+    })
+    .join();
+    assert!(result.is_err());
+
+    assert_eq!(obj.bind().value, 2);
+    obj.bind_mut().value = 3;
+    assert_eq!(obj.bind().value, 3);
+}
+
+#[itest]
+fn object_user_func_lazy_methods() {
+    // Methods are registered when the first instance is created, so they are available on that instance.
+    let obj = Gd::new(LazyPayload { value: 12 });
+    let mut object = obj.upcast::<Object>();
+
+    assert!(object.has_method(StringName::from("get_value")));
+    let value = object.call(StringName::from("get_value"), &[]);
+    assert_eq!(value, 12.to_variant());
+}
+
 // ----------------------------------------------------------------------------------------------------------------------------------------------
 
 #[inline(never)] // force to move "out of scope", can trigger potential dangling pointer errors
@@ -643,6 +826,72 @@ impl GodotExt for ObjPayload {
 
 // ----------------------------------------------------------------------------------------------------------------------------------------------
 
+#[derive(GodotClass, Debug)]
+#[class(unsafe_storage = "unchecked")]
+pub struct UncheckedPayload {
+    value: i32,
+}
+
+// SAFETY: the methods neither call into GDScript nor are they used from other threads.
+unsafe impl UncheckedStorage for UncheckedPayload {}
+
+#[godot_api]
+impl UncheckedPayload {
+    #[func]
+    fn get_value(&self) -> i32 {
+        self.value
+    }
+
+    #[func]
+    fn set_value(&mut self, value: i32) {
+        self.value = value;
+    }
+
+    #[func]
+    fn echo(&self, value: Variant) -> Variant {
+        value
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[derive(GodotClass, Debug)]
+#[class(storage = "sync")]
+pub struct SyncPayload {
+    value: i32,
+}
+
+#[godot_api]
+impl SyncPayload {
+    #[func]
+    fn get_value(&self) -> i32 {
+        self.value
+    }
+
+    #[func]
+    fn set_value(&mut self, value: i32) {
+        self.value = value;
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
+#[derive(GodotClass, Debug)]
+#[class(lazy_methods)]
+pub struct LazyPayload {
+    value: i32,
+}
+
+#[godot_api]
+impl LazyPayload {
+    #[func]
+    fn get_value(&self) -> i32 {
+        self.value
+    }
+}
+
+// ----------------------------------------------------------------------------------------------------------------------------------------------
+
 #[derive(GodotClass, Debug, Eq, PartialEq)]
 pub struct Tracker {
     drop_count: Rc<RefCell<i32>>,
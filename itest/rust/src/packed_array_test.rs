@@ -36,12 +36,54 @@ fn packed_array_from() {
     assert_eq!(array.get(1), 2);
 }
 
+#[itest]
+fn packed_array_extend_from_slice() {
+    let mut array = PackedByteArray::from(&[1, 2]);
+    array.extend_from_slice(&[3, 4, 5]);
+    array.extend_from_slice(&[]);
+
+    assert_eq!(array.to_vec(), vec![1, 2, 3, 4, 5]);
+}
+
+#[itest]
+fn packed_array_extend() {
+    let mut array = PackedByteArray::from(&[1, 2]);
+
+    // Exact size hint.
+    array.extend([3, 4]);
+    // No lower bound in size hint.
+    array.extend((5..=7).filter(|_| true));
+
+    assert_eq!(array.to_vec(), vec![1, 2, 3, 4, 5, 6, 7]);
+}
+
 #[itest]
 fn packed_array_to_vec() {
     let array = PackedByteArray::from(&[1, 2]);
     assert_eq!(array.to_vec(), vec![1, 2]);
 }
 
+#[itest]
+fn packed_array_as_slice() {
+    let array = PackedByteArray::from(&[1, 2, 3]);
+    assert_eq!(array.as_slice(), &[1, 2, 3]);
+
+    let empty = PackedByteArray::new();
+    assert!(empty.as_slice().is_empty());
+}
+
+#[itest]
+fn packed_array_as_mut_slice() {
+    let mut array = PackedFloat32Array::from(&[1.0, 2.0]);
+    let clone = array.clone();
+
+    let slice = array.as_mut_slice();
+    slice.copy_from_slice(&[3.0, 4.0]);
+
+    assert_eq!(array.to_vec(), vec![3.0, 4.0]);
+    assert_eq!(clone.to_vec(), vec![1.0, 2.0]);
+}
+
 /*
 #[itest(skip)]
 fn packed_array_into_iterator() {
@@ -178,4 +220,40 @@ fn packed_array_reverse() {
     let mut array = PackedByteArray::from(&[1, 2]);
     array.reverse();
     assert_eq!(array.to_vec(), vec![2, 1]);
-}
\ No newline at end of file
+}
+
+#[cfg(feature = "rayon")]
+#[itest]
+fn packed_array_par_iter() {
+    use godot::rayon::prelude::*;
+
+    let array = PackedFloat32Array::from_iter((0..10_000).map(|i| i as f32));
+    let sum: f64 = array.par_iter().map(|&x| x as f64).sum();
+    assert_eq!(sum, (0..10_000).sum::<i32>() as f64);
+
+    let chunk_sums: Vec<f32> = array.par_chunks(1000).map(|c| c.iter().sum()).collect();
+    assert_eq!(chunk_sums.len(), 10);
+}
+
+#[cfg(feature = "rayon")]
+#[itest]
+fn packed_array_par_iter_mut() {
+    use godot::rayon::prelude::*;
+
+    let mut array = PackedFloat32Array::from_iter((0..10_000).map(|i| i as f32));
+    let copy = array.clone();
+
+    array.par_iter_mut().for_each(|x| *x *= 2.0);
+    array
+        .par_chunks_mut(999)
+        .enumerate()
+        .for_each(|(i, chunk)| chunk[0] = -(i as f32));
+
+    assert_eq!(array.get(1), 2.0);
+    assert_eq!(array.get(999), -1.0);
+    assert_eq!(array.get(1000), 2000.0);
+
+    // Copy-on-write: the shared buffer was duplicated before the parallel writes.
+    assert_eq!(copy.get(1), 1.0);
+    assert_eq!(copy.get(999), 999.0);
+}
@@ -8,11 +8,11 @@
 use std::time::{Duration, Instant};
 
 use godot::bind::{godot_api, GodotClass};
-use godot::builtin::{ToVariant, Variant, VariantArray};
+use godot::builtin::{GodotString, ToVariant, Variant, VariantArray};
 use godot::engine::Node;
 use godot::obj::Gd;
 
-use crate::{RustTestCase, TestContext};
+use crate::{RustBenchmark, RustTestCase, TestContext};
 
 #[derive(GodotClass, Debug)]
 #[class(init)]
@@ -67,6 +67,53 @@ impl IntegrationTests {
         self.conclude(rust_time, gdscript_time, allow_focus)
     }
 
+    /// Runs all `#[bench]` functions and reports ns/op. The report is written as JSON to `json_path`, or printed
+    /// to stdout if the path is empty.
+    #[func]
+    fn run_all_benchmarks(&mut self, scene_tree: Gd<Node>, json_path: GodotString) -> bool {
+        println!("{FMT_CYAN_BOLD}Run{FMT_END} Godot benchmarks...");
+
+        let (benchmarks, file_count) = super::collect_rust_benchmarks();
+        println!(
+            "  Rust: found {} benchmarks in {} files.",
+            benchmarks.len(),
+            file_count
+        );
+
+        let ctx = TestContext { scene_tree };
+        let mut results = vec![];
+        let mut failed = vec![];
+        let mut last_file = None;
+        for bench in benchmarks {
+            let result = run_rust_benchmark(&bench, &ctx);
+            print_benchmark(&bench, result.as_ref(), &mut last_file);
+
+            match result {
+                Some(result) => results.push(result),
+                None => failed.push(bench.name),
+            }
+        }
+
+        let json = benchmarks_to_json(&results, &failed);
+        let json_path = json_path.to_string();
+        if json_path.is_empty() {
+            println!("\n{json}");
+        } else {
+            std::fs::write(&json_path, json)
+                .unwrap_or_else(|e| panic!("failed to write benchmark report to {json_path}: {e}"));
+            println!("\n  Report written to {json_path}.");
+        }
+
+        let outcome = TestOutcome::from_bool(failed.is_empty());
+        println!(
+            "\nBenchmark result: {outcome}. {} measured; {} failed.",
+            results.len(),
+            failed.len()
+        );
+
+        failed.is_empty()
+    }
+
     fn run_rust_tests(&mut self, tests: Vec<RustTestCase>, scene_tree: Gd<Node>) {
         let ctx = TestContext { scene_tree };
 
@@ -179,6 +226,106 @@ fn run_rust_test(test: &RustTestCase, ctx: &TestContext) -> TestOutcome {
     TestOutcome::from_bool(success.is_some())
 }
 
+const BENCH_WARMUP_RUNS: usize = 50;
+const BENCH_MEASURED_RUNS: usize = 200;
+
+struct BenchResult {
+    name: &'static str,
+    file: &'static str,
+    repetitions: usize,
+
+    // Time per operation, over all measured runs.
+    min_ns: f64,
+    median_ns: f64,
+    mean_ns: f64,
+}
+
+fn run_rust_benchmark(bench: &RustBenchmark, ctx: &TestContext) -> Option<BenchResult> {
+    let err_context = || format!("bench `{}` failed", bench.name);
+    godot::private::handle_panic(err_context, || {
+        for _ in 0..BENCH_WARMUP_RUNS {
+            (bench.function)(ctx);
+        }
+
+        let mut samples: Vec<f64> = (0..BENCH_MEASURED_RUNS)
+            .map(|_| {
+                let elapsed = (bench.function)(ctx);
+                elapsed.as_nanos() as f64 / bench.repetitions as f64
+            })
+            .collect();
+
+        samples.sort_by(|a, b| a.total_cmp(b));
+
+        BenchResult {
+            name: bench.name,
+            file: bench.file,
+            repetitions: bench.repetitions,
+            min_ns: samples[0],
+            median_ns: samples[samples.len() / 2],
+            mean_ns: samples.iter().sum::<f64>() / samples.len() as f64,
+        }
+    })
+}
+
+fn print_benchmark(
+    bench: &RustBenchmark,
+    result: Option<&BenchResult>,
+    last_file: &mut Option<String>,
+) {
+    let outcome = match result {
+        Some(result) => format!(
+            "{:>10.1} ns/op  (min {:.1})",
+            result.median_ns, result.min_ns
+        ),
+        None => TestOutcome::Failed.to_string(),
+    };
+
+    print_test(bench.file.to_string(), bench.name, outcome, last_file);
+}
+
+/// Machine-readable report, for tracking binding overhead over time.
+fn benchmarks_to_json(results: &[BenchResult], failed: &[&str]) -> String {
+    let entries: Vec<String> = results
+        .iter()
+        .map(|result| {
+            format!(
+                "    {{\"name\": {}, \"file\": {}, \"repetitions\": {}, \"runs\": {}, \
+                \"min_ns\": {:.3}, \"median_ns\": {:.3}, \"mean_ns\": {:.3}}}",
+                json_string(result.name),
+                json_string(result.file),
+                result.repetitions,
+                BENCH_MEASURED_RUNS,
+                result.min_ns,
+                result.median_ns,
+                result.mean_ns,
+            )
+        })
+        .collect();
+
+    let failed: Vec<String> = failed.iter().map(|name| json_string(name)).collect();
+
+    format!(
+        "{{\n  \"benchmarks\": [\n{}\n  ],\n  \"failed\": [{}]\n}}",
+        entries.join(",\n"),
+        failed.join(", ")
+    )
+}
+
+fn json_string(s: &str) -> String {
+    let mut result = String::with_capacity(s.len() + 2);
+    result.push('"');
+    for c in s.chars() {
+        match c {
+            '"' => result.push_str("\\\""),
+            '\\' => result.push_str("\\\\"),
+            c if c.is_control() => result.push_str(&format!("\\u{:04x}", c as u32)),
+            c => result.push(c),
+        }
+    }
+    result.push('"');
+    result
+}
+
 /// Prints a test name and its outcome.
 ///
 /// Note that this is run after a test run, so stdout/stderr output during the test will be printed before.
@@ -186,7 +333,7 @@ fn run_rust_test(test: &RustTestCase, ctx: &TestContext) -> TestOutcome {
 fn print_test(
     test_file: String,
     test_case: &str,
-    outcome: TestOutcome,
+    outcome: impl std::fmt::Display,
     last_file: &mut Option<String>,
 ) {
     // Check if we need to open a new category for a file
@@ -56,6 +56,31 @@ fn string_clone() {
     assert_eq!(first, cloned);
 }
 
+#[itest]
+fn string_chars() {
+    let string = GodotString::from("héllo ✓");
+    let expected: Vec<char> = "héllo ✓".chars().collect();
+
+    assert_eq!(string.chars_checked(), expected.as_slice());
+    assert_eq!(unsafe { string.chars_unchecked() }, expected.as_slice());
+
+    let empty = GodotString::new();
+    assert!(empty.chars_checked().is_empty());
+}
+
+#[itest]
+fn string_with_utf8() {
+    let outer = GodotString::from("outer ✓");
+    let inner = GodotString::from("inner");
+
+    // Nested use must not conflict with the thread-local buffer.
+    let joined = outer.with_utf8(|o| inner.with_utf8(|i| format!("{o}/{i}")));
+    assert_eq!(joined, "outer ✓/inner");
+
+    assert_eq!(GodotString::new().with_utf8(str::len), 0);
+    assert_eq!(format!("{outer} {inner:?}"), "outer ✓ \"inner\"");
+}
+
 // ----------------------------------------------------------------------------------------------------------------------------------------------
 
 #[itest]
@@ -75,6 +100,26 @@ fn string_name_default_construct() {
     assert_eq!(back, GodotString::new());
 }
 
+#[itest]
+fn string_name_static_cached() {
+    let first: &'static StringName = godot::builtin::static_sname!("_ready");
+    let second = StringName::from("_ready");
+
+    assert_eq!(first, &second);
+    assert_eq!(GodotString::from(first), GodotString::from("_ready"));
+}
+
+#[itest]
+fn string_name_is_same_interned() {
+    let name = StringName::from("some name");
+    let same = StringName::from(&GodotString::from("some name"));
+    let different = StringName::from("other name");
+
+    assert!(name.is_same_interned(&same));
+    assert!(name.is_same_interned(&name.clone()));
+    assert!(!name.is_same_interned(&different));
+}
+
 #[itest(skip)]
 fn string_name_eq_hash() {
     // TODO
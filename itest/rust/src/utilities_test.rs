@@ -54,3 +54,15 @@ fn utilities_max() {
     );
     assert_eq!(output, Variant::from(-1.0));
 }
+
+#[itest]
+fn utilities_max_many_varargs() {
+    // More varargs than the generated wrapper stores inline.
+    let varargs: Vec<Variant> = (0..20).map(|i| Variant::from(i as f64)).collect();
+
+    let output = max(Variant::from(-1.0), Variant::from(-2.0), &varargs);
+    assert_eq!(output, Variant::from(19.0));
+
+    let output = max(Variant::from(30.0), Variant::from(-2.0), &varargs[..3]);
+    assert_eq!(output, Variant::from(30.0));
+}
@@ -68,6 +68,28 @@ fn variant_conversions() {
     roundtrip(TEST_BASIS);
 }
 
+#[itest]
+fn variant_fast_path_layout() {
+    // Direct tag/payload access must agree with the engine's converters, whether or not `variant-fast-path` is enabled.
+    assert!(Variant::__verify_fast_path());
+
+    roundtrip(-0.0f64);
+    roundtrip(f64::INFINITY);
+    roundtrip(i64::MIN);
+    roundtrip(Vector2::new(-1.5, 2.25));
+
+    assert_eq!(1.5f64.to_variant().get_type(), VariantType::Float);
+    assert_eq!(Vector2::ZERO.to_variant().get_type(), VariantType::Vector2);
+    assert_eq!(
+        f64::try_from_variant(&7i64.to_variant()),
+        Err(VariantConversionError)
+    );
+    assert_eq!(
+        bool::try_from_variant(&Variant::nil()),
+        Err(VariantConversionError)
+    );
+}
+
 #[itest]
 fn variant_forbidden_conversions() {
     truncate_bad::<i8>(128);